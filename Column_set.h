@@ -0,0 +1,125 @@
+#ifndef COLUMN_SET_H
+#define COLUMN_SET_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "DataTypes.h"
+
+// Spaltenweise Ablage geparster Datensätze (Parser_mngr::parse_columnar). Statt einer Zeile aus
+// uintptr_t-Feldern (Doubles bitweise umkopiert, Texte als rohe Zeiger) hat jedes Feld des Formats
+// ein eigenes, typisiertes Array über alle Datensätze:
+//
+//   %s, %V   text[i] / length[i]   Text im String-Arena-Bereich des Parser_mngr (nullterminiert) und Länge (text_length)
+//   %f       real[i]               double
+//   %d       integer[i]            int64_t
+//   %*       -                     übersprungene Spalte (project_format), belegt den Slot, aber kein Array
+//
+// %_ belegt keine Spalte. Spalte c entspricht dem Slot c der Zeilenvariante (format_slot).
+// Ein Verbraucher, der nur die IDs oder nur die Titel braucht, liest damit nur diese Arrays, zusammenhängend.
+// Gefüllt wird Datensatz für Datensatz (set_row) aus der Zeile, die der Parser auf dem Stack beschreibt.
+
+struct column {
+    char kind = 0;                   // 's', 'V', 'f', 'd' oder '*' wie im Format
+    const char** text = nullptr;
+    uint32_t* length = nullptr;
+    double* real = nullptr;
+    int64_t* integer = nullptr;
+};
+
+class Column_set {
+public:
+    Column_set(const std::string& format, size_t rows) : rows(rows)
+    {
+        for (size_t i = 0; i + 1 < format.size(); ++i)
+        {
+            if (format[i] != '%')
+                continue;
+            char kind = format[++i];
+            if (kind == '_')
+                continue;
+            column c;
+            c.kind = kind;
+            if (kind == 's' || kind == 'V')
+            {
+                c.text = new const char*[rows];
+                c.length = new uint32_t[rows];
+            }
+            else if (kind == 'f')
+                c.real = new double[rows];
+            else if (kind == 'd')
+                c.integer = new int64_t[rows];
+            else if (kind != '*')
+                throw std::runtime_error(std::string("unbekannter Feldtyp im Format: %") + kind);
+            columns.push_back(c);
+        }
+    }
+
+    ~Column_set()
+    {
+        for (column& c : columns)
+        {
+            delete[] c.text;
+            delete[] c.length;
+            delete[] c.real;
+            delete[] c.integer;
+        }
+    }
+
+    Column_set(const Column_set&) = delete;
+    Column_set& operator=(const Column_set&) = delete;
+
+    size_t size() const { return rows; }
+    size_t column_count() const { return columns.size(); }
+    const column& operator[](size_t c) const { return columns[c]; }
+
+    // Schreibt Datensatz i aus den Slots einer Zeile (uintptr_t pro Feld, wie sie der Parser füllt)
+    void set_row(size_t i, const uintptr_t* slots)
+    {
+        for (size_t c = 0; c < columns.size(); ++c)
+        {
+            column& col = columns[c];
+            if (col.text)
+            {
+                col.text[i] = (const char*)slots[c];
+                col.length[i] = text_length(col.text[i]);
+            }
+            else if (col.real)
+                memcpy(&col.real[i], &slots[c], sizeof(double));
+            else if (col.integer)
+                col.integer[i] = (int64_t)slots[c];
+        }
+    }
+
+    // Kopiert count Datensätze ab from (in src, gleiches Format) nach to; src == this und überlappende
+    // Bereiche sind erlaubt (Lücken schließen)
+    void copy_rows(const Column_set& src, size_t from, size_t to, size_t count)
+    {
+        for (size_t c = 0; c < columns.size(); ++c)
+        {
+            column& col = columns[c];
+            const column& in = src.columns[c];
+            if (col.text)
+            {
+                memmove(col.text + to, in.text + from, sizeof(*col.text) * count);
+                memmove(col.length + to, in.length + from, sizeof(*col.length) * count);
+            }
+            else if (col.real)
+                memmove(col.real + to, in.real + from, sizeof(*col.real) * count);
+            else if (col.integer)
+                memmove(col.integer + to, in.integer + from, sizeof(*col.integer) * count);
+        }
+    }
+
+    // Kürzt auf die ersten count Datensätze (die Arrays behalten ihre Größe)
+    void truncate(size_t count) { rows = std::min(rows, count); }
+
+private:
+    size_t rows;
+    std::vector<column> columns;
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include <cstdio>
 #include <set>
 #include <unordered_set>
+#include "constants.h"
 
 #ifndef DUPLICATE_DETECTION_DATATYPES
 #define DUPLICATE_DETECTION_DATATYPES
@@ -104,6 +105,68 @@ typedef tuple_t<2,uintptr_t> pair;
 typedef pair** block_t;
 typedef unsigned short token;
 
+// Texte im String-Arena-Bereich des Parsers: [uint32_t Länge][Bytes]['\0']. Die Textfelder der Zeilen zeigen
+// auf die Bytes, die Länge steht direkt davor. Tokenizer und generate_set arbeiten damit auf (Zeiger, Länge)
+// und lesen nie über das Textende hinaus.
+static constexpr size_t text_prefix = sizeof(uint32_t);
+
+struct text_view {
+    const char* data;
+    uint32_t length;
+
+    const char* end() const { return data + length; }
+};
+
+inline uint32_t text_length(const char* text)
+{
+    uint32_t length;
+    memcpy(&length, text - text_prefix, sizeof(length));
+    return length;
+}
+
+inline text_view field_text(uintptr_t field)
+{
+    const char* text = (const char*)field;
+    return {text, text_length(text)};
+}
+
+// leeres Textfeld außerhalb der Arena, ebenfalls mit Länge davor
+alignas(4) inline const char empty_text_storage[text_prefix + 1] = {};
+inline const char* const empty_text = empty_text_storage + text_prefix;
+
+// Zerlegt einen normalisierten Text in die Zahlen der Jaccard-Mengen: Wörter (getrennt durch whitespace)
+// ab 4 Zeichen liefern jedes 4-Gramm als uint32_t, kürzere Wörter ihre 1-3 Bytes (mit Nullen aufgefüllt).
+inline void collect_shingles(text_view text, uint32_t* out, uint32_t& count)
+{
+    const char* p = text.data;
+    const char* end = text.end();
+    while (p < end)
+    {
+        if ((unsigned char)*p == whitespace)
+        {
+            ++p;
+            continue;
+        }
+        const char* word = p;
+        while (p < end && (unsigned char)*p != whitespace)
+            ++p;
+        size_t length = p - word;
+        if (length < 4)
+        {
+            uint32_t numeral = 0;
+            memcpy(&numeral, word, length);
+            out[count++] = numeral;
+            continue;
+        }
+        for (size_t i = 0; i + 4 <= length; ++i)
+        {
+            uint32_t numeral;
+            memcpy(&numeral, word + i, 4);
+            out[count++] = numeral;
+        }
+    }
+}
+
 typedef struct partition_t
 {
     pair* data; // Pointer auf die Daten der Partition
@@ -225,159 +288,9 @@ struct laptop
     }
 
     std::unordered_set<uint32_t>* generate_set() {
-        // Stelle sicher, dass der numeral_buffer korrekt verlinkt ist
-        auto processString = [&](char *str, laptop *obj)
-        {
-            char *p = str;
-            int tokenValue = 0;
-
-            const void *jumpTableLoop[256] =
-                {
-                    &&eol, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 0–7
-                    &&stn, &&stn, &&eol, &&stn, &&stn, &&stn, &&stn, &&stn,             // 8–15
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 16–23
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 24–31
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 32–39
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 40–47
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 48–55
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 56–63
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 64–71
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 72–79
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 80–87
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 88–95
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 96–103
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 104–111
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 112–119
-                    &&stn, &&stn, &&stn, &&stn, &&loop_whitespace, &&stn, &&stn, &&stn, // 120–127
-                };
-
-            const void *jumpTableFound8[256] =
-                {
-                    &&sChar, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 0–7
-                    &&gt1char, &&gt1char, &&sChar, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 8–15
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 16–23
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 24–31
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 32–39
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 40–47
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 48–55
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 56–63
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 64–71
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 72–79
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 80–87
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 88–95
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 96–103
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 104–111
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 112–119
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&sChar, &&gt1char, &&gt1char, &&gt1char,   // 120–127
-                };
-
-            const void *jumpTableFound16[256] =
-                {
-                    &&sShort, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char,  // 0–7
-                    &&ge2char, &&ge2char, &&sShort, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char,  // 8–15
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 16–23
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 24–31
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 32–39
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 40–47
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 48–55
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 56–63
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 64–71
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 72–79
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 80–87
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 88–95
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 96–103
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 104–111
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 112–119
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&sShort, &&ge2char, &&ge2char, &&ge2char, // 120–127
-                };
-
-            const void *jumpTableFound24[256] =
-                {
-                    &&ssShort, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, // 0–7
-                    &&sIntL, &&sIntL, &&ssShort, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, // 8–15
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 16–23
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 24–31
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 32–39
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 40–47
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 48–55
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 56–63
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 64–71
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 72–79
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 80–87
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 88–95
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 96–103
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 104–111
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 112–119
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&ssShort, &&sIntL, &&sIntL, &&sIntL, // 120–127
-                };
-
-            const void *jumpTableIntLoop[256] =
-                {
-                    &&eol, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,             // 0–7
-                    &&sIntL, &&sIntL, &&eol, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,             // 8–15
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 16–23
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 24–31
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 32–39
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 40–47
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 48–55
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 56–63
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 64–71
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 72–79
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 80–87
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 88–95
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 96–103
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 104–111
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 112–119
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&loop_whitespace, &&sIntL, &&sIntL, &&sIntL, // 120–127
-                };
-            
-            goto *jumpTableLoop[*p];
-            uint32_t numeral;
-                //_|_|_|c-c-c-c ... |
-
-            stn :
-                // save current destination
-                char *pos = p;
-                char roffset = 0;
-                goto *jumpTableFound8[*(++p)]; // if the next char after dest is a whitespace, jump to save char, to only save one char in a number
-            gt1char: //otherwise we will land here
-                goto *jumpTableFound16[*(++p)]; //if the 2nd byte after dst is a whitespace, jump to sShort for we got at least 2 letters we will take as 1 int with 16bit offset
-            ge2char: //otherwise we will land here
-                goto *jumpTableFound24[*(++p)]; //if the 3rd byte after dst is a whitespace, jump to ssShort for we got 3 letters we will take as 1 int with 8 bit offset
-            sIntL: //otherwise we got 4 or mehr letters in a row, therefor we loop_saveInt
-                numeral = *((uint32_t*)pos); //get numeral at pos and increment pos for next possible step to be in a different position
-                pos++;
-                obj->numeral_buffer[obj->numNumerals] = numeral; //save numeral to buffer
-                obj->numNumerals++; //increment number of numerals for correct saving location and later work
-                goto *jumpTableIntLoop[*(++p)]; //if the next byte is also not a whitespace, will land back here, otherwise will loop whitespace 
-            
-            sChar:
-                roffset = 24; //have a 24 offset ready for shift, and jump to save as integer;
-                goto sInt;
-            sShort: //save 2 byte in an integer by offsetting the current data >> 16
-                roffset = 16;
-                goto sInt;
-            ssShort: //save 3 byte in an int by offsetting the current data >> 8
-                roffset = 8;
-                goto sInt;
-            sInt:
-                numeral = *((uint32_t*)pos);
-                uint32_t onumeral = numeral >> roffset; //get data at destination for exactly the filed bytes we need
-                obj->numeral_buffer[obj->numNumerals] = (uint32_t)onumeral;  //save the shifted numeral 
-                obj->numNumerals++;// increase for correct save location
-                goto *jumpTableLoop[*p];
-                                
-            loop_whitespace:
-                ++p;
-                goto *jumpTableLoop[*p];
-
-            eol:
-                return;
-        };
-
-        // Zuerst den String aus Index 0 verarbeiten
+        // Beschreibung aus Index 0 über (Zeiger, Länge) zerlegen, numeral_buffer muss verlinkt sein
         numNumerals = 0; // Sicherstellen, dass wir bei 0 anfangen
-        processString(reinterpret_cast<char *>(this->descriptor->data[0]), this);
+        collect_shingles(field_text(this->descriptor->data[0]), numeral_buffer, numNumerals);
         
         // Erstelle ein Set aus dem numeral_buffer für den ersten String
         std::unordered_set<uint32_t>* combined_set = new std::unordered_set<uint32_t>(numeral_buffer, numeral_buffer + numNumerals);
@@ -458,158 +371,9 @@ struct storage_drive
 
     std::unordered_set<uint32_t> *generate_set()
     {
-        // Stelle sicher, dass der numeral_buffer korrekt verlinkt ist
-        auto processString = [&](char *str, storage_drive *obj)
-        {
-            char *p = str;
-            int tokenValue = 0;
-            const void *jumpTableLoop[256] =
-                {
-                    &&eol, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 0–7
-                    &&stn, &&stn, &&eol, &&stn, &&stn, &&stn, &&stn, &&stn,             // 8–15
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 16–23
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 24–31
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 32–39
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 40–47
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 48–55
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 56–63
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 64–71
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 72–79
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 80–87
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 88–95
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 96–103
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 104–111
-                    &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn, &&stn,             // 112–119
-                    &&stn, &&stn, &&stn, &&stn, &&loop_whitespace, &&stn, &&stn, &&stn, // 120–127
-                };
-
-            const void *jumpTableFound8[256] =
-                {
-                    &&sChar, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 0–7
-                    &&gt1char, &&gt1char, &&sChar, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 8–15
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 16–23
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 24–31
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 32–39
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 40–47
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 48–55
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 56–63
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 64–71
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 72–79
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 80–87
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 88–95
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 96–103
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 104–111
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&gt1char,   // 112–119
-                    &&gt1char, &&gt1char, &&gt1char, &&gt1char, &&sChar, &&gt1char, &&gt1char, &&gt1char,   // 120–127
-                };
-
-            const void *jumpTableFound16[256] =
-                {
-                    &&sShort, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char,  // 0–7
-                    &&ge2char, &&ge2char, &&sShort, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char,  // 8–15
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 16–23
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 24–31
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 32–39
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 40–47
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 48–55
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 56–63
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 64–71
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 72–79
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 80–87
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 88–95
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 96–103
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 104–111
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&ge2char, // 112–119
-                    &&ge2char, &&ge2char, &&ge2char, &&ge2char, &&sShort, &&ge2char, &&ge2char, &&ge2char, // 120–127
-                };
-
-            const void *jumpTableFound24[256] =
-                {
-                    &&ssShort, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, // 0–7
-                    &&sIntL, &&sIntL, &&ssShort, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, // 8–15
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 16–23
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 24–31
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 32–39
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 40–47
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 48–55
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 56–63
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 64–71
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 72–79
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 80–87
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 88–95
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 96–103
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 104–111
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,   // 112–119
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&ssShort, &&sIntL, &&sIntL, &&sIntL, // 120–127
-                };
-
-            const void *jumpTableIntLoop[256] =
-                {
-                    &&eol, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,             // 0–7
-                    &&sIntL, &&sIntL, &&eol, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,             // 8–15
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 16–23
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 24–31
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 32–39
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 40–47
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 48–55
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 56–63
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 64–71
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 72–79
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 80–87
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 88–95
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 96–103
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 104–111
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&sIntL,           // 112–119
-                    &&sIntL, &&sIntL, &&sIntL, &&sIntL, &&loop_whitespace, &&sIntL, &&sIntL, &&sIntL, // 120–127
-                };
-
-            goto *jumpTableLoop[*p];
-            uint32_t numeral;
-            //_|_|_|c-c-c-c ... |
-
-        stn:
-            // save current destination
-            char *pos = p;
-            char roffset = 0;
-            goto *jumpTableFound8[*(++p)];  // if the next char after dest is a whitespace, jump to save char, to only save one char in a number
-        gt1char:                            // otherwise we will land here
-            goto *jumpTableFound16[*(++p)]; // if the 2nd byte after dst is a whitespace, jump to sShort for we got at least 2 letters we will take as 1 int with 16bit offset
-        ge2char:                            // otherwise we will land here
-            goto *jumpTableFound24[*(++p)]; // if the 3rd byte after dst is a whitespace, jump to ssShort for we got 3 letters we will take as 1 int with 8 bit offset
-        sIntL:                              // otherwise we got 4 or more letters in a row, therefor we loop_saveInt
-            numeral = *((uint32_t *)pos);   // get numeral at pos and increment pos for next possible step to be in a different position
-            pos++;
-            obj->numeral_buffer[obj->numNumerals] = numeral; // save numeral to buffer
-            obj->numNumerals++;                              // increment number of numerals for correct saving location and later work
-            goto *jumpTableIntLoop[*(++p)];                  // if the next byte is also not a whitespace, will land back here, otherwise will loop whitespace
-
-        sChar:
-            roffset = 24; // have a 24 offset ready for shift, and jump to save as integer;
-            goto sInt;
-        sShort: // save 2 byte in an integer by offsetting the current data >> 16
-            roffset = 16;
-            goto sInt;
-        ssShort: // save 3 byte in an int by offsetting the current data >> 8
-            roffset = 8;
-            goto sInt;
-        sInt:
-            numeral = *((uint32_t *)pos);
-            uint32_t onumeral = numeral >> roffset;                     // get data at destination for exactly the filed bytes we need
-            obj->numeral_buffer[obj->numNumerals] = (uint32_t)onumeral; // save the shifted numeral
-            obj->numNumerals++;                                         // increase for correct save location
-            goto *jumpTableLoop[*p];
-
-        loop_whitespace:
-            ++p;
-            goto *jumpTableLoop[*p];
-
-        eol:
-            return;
-        };
-
-        // Zuerst den String aus Index 0 verarbeiten
+        // Beschreibung aus Index 0 über (Zeiger, Länge) zerlegen, numeral_buffer muss verlinkt sein
         numNumerals = 0; // Sicherstellen, dass wir bei 0 anfangen
-        processString(reinterpret_cast<char *>(this->descriptor->data[0]), this);
+        collect_shingles(field_text(this->descriptor->data[0]), numeral_buffer, numNumerals);
         
         std::unordered_set<uint32_t>* combined_set = new std::unordered_set<uint32_t>(numeral_buffer, numeral_buffer + numNumerals);
         
@@ -0,0 +1,93 @@
+#ifndef DICTIONARY_SET_H
+#define DICTIONARY_SET_H
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include "DataTypes.h"
+
+// Wörterbuchkodierung von Textspalten mit wenigen verschiedenen Werten (Parser_mngr::dictionary_encode).
+// In der Storage-Datei wiederholen sich z.B. Marke und Kategorie über alle Datensätze. Eine kodierte Spalte
+// bekommt eine Wertetabelle (jeder Text einmal, Zeiger in die String-Arena des Parser_mngr) und pro Datensatz
+// einen uint32_t-Code. Die Zeilen selbst bleiben unverändert, ihre Slots zeigen weiter auf die Texte.
+// Der Tokenizer zerlegt jeden Wert nur einmal und überträgt das Ergebnis über den Code auf alle Datensätze
+// (Tokenization_mngr::tokenize_multithreaded).
+
+struct text_dictionary {
+    std::vector<const char*> values;   // Text je Code
+    std::vector<uint32_t> occurrences; // Anzahl Datensätze je Code
+    std::vector<uint32_t> codes;       // Code je Datensatz
+};
+
+class Dictionary_set {
+public:
+    // Eine Spalte wird nur kodiert, wenn jeder Wert im Mittel mindestens so oft vorkommt
+    static constexpr size_t min_repeat = 8;
+
+    // slots: Slots pro Zeile (Feldzahl des Formats ohne %_)
+    Dictionary_set(size_t slots, size_t rows) : rows(rows), dictionaries(slots, nullptr) {}
+
+    ~Dictionary_set()
+    {
+        for (text_dictionary* dictionary : dictionaries)
+            delete dictionary;
+    }
+
+    Dictionary_set(const Dictionary_set&) = delete;
+    Dictionary_set& operator=(const Dictionary_set&) = delete;
+
+    size_t size() const { return rows; }
+    size_t slot_count() const { return dictionaries.size(); }
+
+    // nullptr: der Slot ist nicht kodiert (kein Text oder zu viele verschiedene Werte)
+    const text_dictionary* operator[](size_t slot) const { return dictionaries[slot]; }
+
+    size_t encoded_count() const
+    {
+        size_t count = 0;
+        for (const text_dictionary* dictionary : dictionaries)
+            count += dictionary != nullptr;
+        return count;
+    }
+
+    // Kodiert den Textslot slot aller Zeilen (width Slots pro Zeile). Bricht ab, sobald die Spalte mehr als
+    // rows / min_repeat verschiedene Werte hat, und gibt dann false zurück. Verschiedene Slots dürfen
+    // parallel kodiert werden.
+    bool encode(const uintptr_t* row_slots, size_t width, size_t slot)
+    {
+        size_t limit = rows / min_repeat;
+        // gehört erst nach vollständiger Kodierung dem Dictionary_set, bei Abbruch oder Ausnahme wird freigegeben
+        std::unique_ptr<text_dictionary> dictionary = std::make_unique<text_dictionary>();
+        dictionary->codes.resize(rows);
+
+        std::unordered_map<std::string_view, uint32_t> lookup;
+        lookup.reserve(std::min<size_t>(limit, 4096));
+        const uintptr_t* field = row_slots + slot;
+        for (size_t i = 0; i < rows; ++i, field += width)
+        {
+            text_view text = field_text(*field);
+            std::string_view key(text.data, text.length);
+            auto it = lookup.find(key);
+            if (it == lookup.end())
+            {
+                if (dictionary->values.size() == limit)
+                    return false;
+                it = lookup.emplace(key, (uint32_t)dictionary->values.size()).first;
+                dictionary->values.push_back(text.data);
+                dictionary->occurrences.push_back(0);
+            }
+            dictionary->codes[i] = it->second;
+            ++dictionary->occurrences[it->second];
+        }
+        dictionaries[slot] = dictionary.release();
+        return true;
+    }
+
+private:
+    size_t rows;
+    std::vector<text_dictionary*> dictionaries;
+};
+
+#endif
@@ -4,8 +4,21 @@
 #include <vector>
 #include "Evaluation_mngr.h"
 
-float Evaluation_mngr::evaluateMatches(dataSet<matching>* matches, dataSet<match>* Solution)
+// ID-Spalten einer Lösungsdatei ("%d,%d")
+static void solution_columns(const Column_set& Solution, const int64_t*& ids1, const int64_t*& ids2)
 {
+    if (Solution.column_count() != 2 || !Solution[0].integer || !Solution[1].integer)
+        throw std::runtime_error("Lösungsdatei muss zwei ID-Spalten haben (%d,%d)");
+    ids1 = Solution[0].integer;
+    ids2 = Solution[1].integer;
+}
+
+float Evaluation_mngr::evaluateMatches(dataSet<matching>* matches, const Column_set& Solution)
+{
+    const int64_t* solution_ids1;
+    const int64_t* solution_ids2;
+    solution_columns(Solution, solution_ids1, solution_ids2);
+
     // Bestimme die maximale ID, um einen geeigneten Puffer zu erstellen
     size_t max_id = 0;
     size_t total_matches = 0;
@@ -23,7 +36,7 @@ float Evaluation_mngr::evaluateMatches(dataSet<matching>* matches, dataSet<match
     }
     
     // Debugging-Informationen
-    printf("Ground-Truth-Größe: %zu\n", Solution->size);
+    printf("Ground-Truth-Größe: %zu\n", Solution.size());
     printf("Anzahl verarbeiteter Matches: %zu\n", total_matches);
     printf("Maximale gefundene ID: %zu\n", max_id);
     
@@ -55,9 +68,9 @@ float Evaluation_mngr::evaluateMatches(dataSet<matching>* matches, dataSet<match
     // Erstelle ein Set für die bereits als true positive markierten Matches
     std::vector<std::unordered_set<size_t>> marked_matches(buffer_size);
     
-    for (size_t i = 0; i < Solution->size; i++) {
-        size_t solution_id1 = static_cast<size_t>((*Solution)[i].data[0]);
-        size_t solution_id2 = static_cast<size_t>((*Solution)[i].data[1]);
+    for (size_t i = 0; i < Solution.size(); i++) {
+        size_t solution_id1 = static_cast<size_t>(solution_ids1[i]);
+        size_t solution_id2 = static_cast<size_t>(solution_ids2[i]);
         
         if (solution_id1 < buffer_size) {
             if (indexed_matches[solution_id1].find(solution_id2) != indexed_matches[solution_id1].end()) {
@@ -107,5 +120,55 @@ float Evaluation_mngr::evaluateMatches(dataSet<matching>* matches, dataSet<match
     printf("  - Recall: %.4f\n", recall);
     printf("  - F1-Score: %.4f\n", f1_score);
     
+    return f1_score;
+}
+float Evaluation_mngr::evaluateMatches(const Result_file& result, const Column_set& Solution)
+{
+    const int64_t* solution_ids1;
+    const int64_t* solution_ids2;
+    solution_columns(Solution, solution_ids1, solution_ids2);
+
+    // Die Datei enthält jedes Paar genau einmal, sortiert als (kleinere ID, größere ID):
+    // jedes Lösungspaar ist eine binäre Suche, alle übrigen Matches sind False Positives
+    std::unordered_set<uint64_t> seen_pairs; // Lösungspaare, die mehrfach vorkommen, nur einmal zählen
+    size_t true_positives = 0;
+    size_t false_negatives = 0;
+
+    for (size_t i = 0; i < Solution.size(); i++) {
+        uint64_t solution_id1 = static_cast<uint64_t>(solution_ids1[i]);
+        uint64_t solution_id2 = static_cast<uint64_t>(solution_ids2[i]);
+
+        const match_record* found = result.find(solution_id1, solution_id2);
+        if (!found) {
+            false_negatives++;
+        } else if (seen_pairs.insert((uint64_t)(found - result.matches())).second) {
+            true_positives++;
+        }
+    }
+    size_t false_positives = result.match_count() - true_positives;
+
+    float precision = 0.0f;
+    if (true_positives + false_positives > 0) {
+        precision = static_cast<float>(true_positives) / (true_positives + false_positives);
+    }
+
+    float recall = 0.0f;
+    if (true_positives + false_negatives > 0) {
+        recall = static_cast<float>(true_positives) / (true_positives + false_negatives);
+    }
+
+    float f1_score = 0.0f;
+    if (precision + recall > 0) {
+        f1_score = 2.0f * (precision * recall) / (precision + recall);
+    }
+
+    printf("\n✓ Evaluationsergebnisse (Ergebnisdatei, %zu Matches, %zu Cluster):\n", result.match_count(), result.cluster_count());
+    printf("  - Wahre Positive (TP): %zu\n", true_positives);
+    printf("  - Falsche Positive (FP): %zu\n", false_positives);
+    printf("  - Falsche Negative (FN): %zu\n", false_negatives);
+    printf("  - Precision: %.4f\n", precision);
+    printf("  - Recall: %.4f\n", recall);
+    printf("  - F1-Score: %.4f\n", f1_score);
+
     return f1_score;
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 //
 
 #include "DataTypes.h"
+#include "Result_file.h"
+#include "Column_set.h"
 
 #ifndef DUPLICATEDETECTION_EVALUATION_MNGR_H
 #define DUPLICATEDETECTION_EVALUATION_MNGR_H
@@ -19,7 +21,9 @@ public:
     ~Evaluation_mngr(){}
 
 public:
-    float evaluateMatches(dataSet<matching>* matches, dataSet<match>* Solution); // set class resources, before forking, so workers can use this
+    // Solution: Lösungsdatei spaltenweise geparst ("%d,%d", Parser_mngr::parse_columnar), gelesen werden nur die beiden ID-Spalten
+    float evaluateMatches(dataSet<matching>* matches, const Column_set& Solution); // set class resources, before forking, so workers can use this
+    float evaluateMatches(const Result_file& result, const Column_set& Solution); // gemappte Ergebnisdatei (Output_mngr, ".bin"), ohne Parsen
 };
 
 
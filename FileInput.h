@@ -2,8 +2,9 @@
 #define DUPLICATEDETECTION_FILEINPUT_H
 
 #include "DataTypes.h"
-#include "Parser_mngr.h"
 #include "Utillity.h"
+#include "simd_utils.h"
+#include "io_uring_reader.h"
 
 #include <fstream>
 #include <string>
@@ -13,32 +14,411 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <poll.h>
 #include <cstdio>
+#include <cstring>
 #include <filesystem>
 #include <stdexcept>
+#include <thread>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <exception>
+#include <glob.h>
+#include <chrono>
+#include <memory>
+#include <sys/resource.h>
+
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef WITH_ZSTD
+#include <zstd.h>
+#endif
+
+// Kopf der Zeilenindex-Datei (<datei>.lidx), danach folgen line_count + 1 Offsets als uint64_t
+struct line_index_header
+{
+    char magic[8];        // "DDLIDX\0\0"
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t file_size;   // Größe der indizierten Datei
+    int64_t mtime_sec;    // Änderungszeit der indizierten Datei
+    int64_t mtime_nsec;
+    uint64_t sample_hash; // FNV-1a über Anfang und Ende der Datei
+    uint64_t line_count;
+    uint64_t padding;     // Offsets beginnen 64-Byte-ausgerichtet
+};
+
+static const uint32_t line_index_version = 2; // 2: Datensatzanfänge statt aller Zeilenumbrüche
+
+// --- Komprimierte Eingaben ---
+// gzip wird mit -DWITH_ZLIB (Linker: -lz), zstd mit -DWITH_ZSTD (Linker: -lzstd) unterstützt.
+// File erkennt die Kompression an den Magic Bytes und dekomprimiert direkt in den Speicher,
+// der Parser arbeitet danach wie auf einer gemappten unkomprimierten Datei.
+
+enum compression_type { compression_none, compression_gzip, compression_zstd };
+
+static constexpr size_t decompress_padding = 64; // Nullbytes hinter den Daten als Leseüberhang für den Parser
+
+inline compression_type detect_compression(const char* data, size_t size)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    if (size >= 3 && p[0] == 0x1f && p[1] == 0x8b && p[2] == 0x08) return compression_gzip;
+    if (size >= 4 && p[0] == 0x28 && p[1] == 0xb5 && p[2] == 0x2f && p[3] == 0xfd) return compression_zstd;
+    return compression_none;
+}
+
+// Verteilt die Indizes [0, count) über einen atomaren Zähler auf num_threads Threads
+template <typename F>
+inline void parallel_for_each_index(size_t count, size_t num_threads, F&& work)
+{
+    num_threads = std::max<size_t>(1, std::min(num_threads, count));
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++)
+            work(i);
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < num_threads; ++t)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread& th : threads)
+        th.join();
+}
+
+#ifdef WITH_ZLIB
+// Dekomprimiert genau ein gzip-Member ab src nach out.
+// Gibt die Anzahl gelesener Bytes zurück, 0 wenn an src kein vollständiges, gültiges Member (CRC/Länge geprüft) beginnt.
+// size ist der Rest der Datei, nicht die Länge des Members: out startet deshalb klein, wächst schrittweise und wird
+// am Ende auf die entpackte Größe gekürzt, sonst hielte jedes Member Speicher in der Größe der ganzen Restdatei.
+inline size_t inflate_gzip_member(const unsigned char* src, size_t size, std::vector<char>& out)
+{
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (inflateInit2(&zs, 16 + MAX_WBITS) != Z_OK) return 0;
+
+    out.resize(std::clamp<size_t>(size * 4, 4096, 1 << 20));
+    size_t produced = 0;
+    size_t consumed = 0;
+    zs.next_in = (Bytef*)src;
+    while (true)
+    {
+        if (zs.avail_in == 0)
+        {
+            size_t offered = zs.next_in - src;
+            if (offered >= size) break; // Eingabe zu Ende, Member unvollständig
+            zs.avail_in = (uInt)std::min<size_t>(size - offered, 1u << 30);
+        }
+        if (produced == out.size()) out.resize(out.size() * 2);
+        zs.next_out = (Bytef*)out.data() + produced;
+        zs.avail_out = (uInt)std::min<size_t>(out.size() - produced, 1u << 30);
+
+        uInt before = zs.avail_out;
+        int ret = inflate(&zs, Z_NO_FLUSH);
+        produced += before - zs.avail_out;
+        if (ret == Z_STREAM_END)
+        {
+            consumed = zs.next_in - src;
+            break;
+        }
+        if (ret != Z_OK && ret != Z_BUF_ERROR) break;
+    }
+    inflateEnd(&zs);
+    out.resize(consumed ? produced : 0);
+    out.shrink_to_fit();
+    return consumed;
+}
+
+// Mehrteilige gzip-Dateien (pigz, bgzip, aneinandergehängte .gz) werden parallel entpackt: jeder Thread versucht
+// an einem Kandidaten (Magic 1f 8b 08) ein Member zu dekodieren, danach wird die Kette gültiger Member ab Offset 0
+// verfolgt. Kandidaten, die zufällig in komprimierten Daten liegen, scheitern an der CRC und werden verworfen.
+// Eine einteilige gzip-Datei lässt sich so nicht aufteilen und wird von einem Thread entpackt.
+inline char* decompress_gzip(const char* data, size_t size, size_t& out_size, size_t num_threads)
+{
+    const unsigned char* src = (const unsigned char*)data;
+    std::vector<size_t> candidates;
+    for (const unsigned char* p = src; (p = (const unsigned char*)memchr(p, 0x1f, size - (p - src))) != nullptr; ++p)
+    {
+        size_t pos = p - src;
+        if (pos + 10 <= size && p[1] == 0x8b && p[2] == 0x08 && (p[3] & 0xe0) == 0)
+            candidates.push_back(pos);
+        if (pos + 1 >= size) break;
+    }
+
+    std::vector<size_t> member_end(candidates.size(), 0);
+    std::vector<std::vector<char>> member_out(candidates.size());
+    parallel_for_each_index(candidates.size(), num_threads, [&](size_t i) {
+        size_t used = inflate_gzip_member(src + candidates[i], size - candidates[i], member_out[i]);
+        member_end[i] = used ? candidates[i] + used : 0;
+    });
+
+    // Kette der Member ab Offset 0 verfolgen
+    std::vector<std::vector<char>*> parts;
+    std::vector<std::vector<char>> fallback_parts;
+    fallback_parts.reserve(candidates.size() + 1);
+    size_t pos = 0;
+    size_t total = 0;
+    while (pos < size)
+    {
+        size_t idx = std::lower_bound(candidates.begin(), candidates.end(), pos) - candidates.begin();
+        if (idx < candidates.size() && candidates[idx] == pos && member_end[idx] > 0)
+        {
+            parts.push_back(&member_out[idx]);
+            pos = member_end[idx];
+        }
+        else
+        {
+            bool only_padding = true;
+            for (size_t i = pos; i < size && only_padding; ++i)
+                only_padding = src[i] == 0;
+            if (only_padding) break; // Nullbytes am Ende ignoriert auch gzip selbst
+
+            fallback_parts.emplace_back();
+            size_t used = inflate_gzip_member(src + pos, size - pos, fallback_parts.back());
+            if (!used) throw std::runtime_error("Ungültige gzip-Daten ab Offset " + std::to_string(pos));
+            parts.push_back(&fallback_parts.back());
+            pos += used;
+        }
+        total += parts.back()->size();
+    }
+
+    char* out = new char[total + decompress_padding]();
+    size_t offset = 0;
+    for (std::vector<char>* part : parts)
+    {
+        memcpy(out + offset, part->data(), part->size());
+        offset += part->size();
+    }
+    printf("gzip: %zu Member, %zu -> %zu Bytes\n", parts.size(), size, total);
+    out_size = total;
+    return out;
+}
+#endif
+
+#ifdef WITH_ZSTD
+// zstd-Frames sind selbstbeschreibend: Framegrenzen und (meist) die entpackte Größe stehen im Header.
+// Bei bekannten Größen wird jeder Frame parallel direkt an seine Zielposition entpackt (seekable zstd,
+// zstdmt, pzstd); Skippable Frames (z.B. die Seek-Tabelle) werden übersprungen. Fehlt eine Größe,
+// wird seriell über die Streaming-API entpackt.
+inline char* decompress_zstd(const char* data, size_t size, size_t& out_size, size_t num_threads)
+{
+    struct zstd_frame { size_t src, src_size, dst, dst_size; };
+    std::vector<zstd_frame> frames;
+    bool sizes_known = true;
+    size_t total = 0;
+    for (size_t pos = 0; pos < size;)
+    {
+        size_t frame_size = ZSTD_findFrameCompressedSize(data + pos, size - pos);
+        if (ZSTD_isError(frame_size))
+            throw std::runtime_error(std::string("Ungültige zstd-Daten: ") + ZSTD_getErrorName(frame_size));
+
+        uint32_t magic;
+        memcpy(&magic, data + pos, sizeof(magic));
+        if ((magic & 0xFFFFFFF0u) != 0x184D2A50u) // kein Skippable Frame
+        {
+            unsigned long long content = ZSTD_getFrameContentSize(data + pos, frame_size);
+            if (content == ZSTD_CONTENTSIZE_UNKNOWN || content == ZSTD_CONTENTSIZE_ERROR)
+                sizes_known = false;
+            else
+            {
+                frames.push_back({pos, frame_size, total, (size_t)content});
+                total += content;
+            }
+        }
+        pos += frame_size;
+    }
+
+    if (!sizes_known)
+    {
+        std::vector<char> plain(std::max<size_t>(size * 4, 4096));
+        ZSTD_DStream* stream = ZSTD_createDStream();
+        ZSTD_inBuffer in = {data, size, 0};
+        size_t produced = 0;
+        while (in.pos < in.size)
+        {
+            if (produced == plain.size()) plain.resize(plain.size() * 2);
+            ZSTD_outBuffer out = {plain.data() + produced, plain.size() - produced, 0};
+            size_t ret = ZSTD_decompressStream(stream, &out, &in);
+            if (ZSTD_isError(ret))
+            {
+                ZSTD_freeDStream(stream);
+                throw std::runtime_error(std::string("zstd-Fehler: ") + ZSTD_getErrorName(ret));
+            }
+            produced += out.pos;
+        }
+        ZSTD_freeDStream(stream);
+
+        char* out = new char[produced + decompress_padding]();
+        memcpy(out, plain.data(), produced);
+        printf("zstd (seriell): %zu -> %zu Bytes\n", size, produced);
+        out_size = produced;
+        return out;
+    }
+
+    char* out = new char[total + decompress_padding]();
+    std::atomic<bool> failed{false};
+    parallel_for_each_index(frames.size(), num_threads, [&](size_t i) {
+        const zstd_frame& f = frames[i];
+        ZSTD_DCtx* dctx = ZSTD_createDCtx();
+        size_t ret = ZSTD_decompressDCtx(dctx, out + f.dst, f.dst_size, data + f.src, f.src_size);
+        ZSTD_freeDCtx(dctx);
+        if (ZSTD_isError(ret) || ret != f.dst_size) failed = true;
+    });
+    if (failed)
+    {
+        delete[] out;
+        throw std::runtime_error("zstd-Frame konnte nicht entpackt werden");
+    }
+    printf("zstd: %zu Frames, %zu -> %zu Bytes\n", frames.size(), size, total);
+    out_size = total;
+    return out;
+}
+#endif
+
+// Entpackt data in einen neuen Puffer (new[], mit decompress_padding Nullbytes dahinter)
+inline char* decompress_buffer(compression_type type, [[maybe_unused]] const char* data, size_t size, size_t& out_size, [[maybe_unused]] size_t num_threads)
+{
+    switch (type)
+    {
+        case compression_gzip:
+#ifdef WITH_ZLIB
+            return decompress_gzip(data, size, out_size, num_threads);
+#else
+            throw std::runtime_error("gzip-Eingabe erkannt, aber ohne -DWITH_ZLIB gebaut");
+#endif
+        case compression_zstd:
+#ifdef WITH_ZSTD
+            return decompress_zstd(data, size, out_size, num_threads);
+#else
+            throw std::runtime_error("zstd-Eingabe erkannt, aber ohne -DWITH_ZSTD gebaut");
+#endif
+        default:
+            out_size = size;
+            return nullptr;
+    }
+}
+
+// Wie File die Datei in den Speicher bringt
+enum read_backend {
+    read_mmap,  // mmap, Seiten werden beim ersten Zugriff der Parser-Threads nachgeladen
+    read_uring  // io_uring in einen Puffer, mehrere große Lesezugriffe gleichzeitig, Parser startet blockweise
+};
+
+// Wann die Seiten einer gemappten Eingabe geladen werden (nur read_mmap). Ohne Prefault nehmen die
+// Threads in threaded_line_split die Page Faults mitten in der Parse-Schleife.
+enum prefault_policy {
+    prefault_none,     // beim ersten Zugriff (bisheriges Verhalten)
+    prefault_populate, // MAP_POPULATE: mmap kehrt erst zurück, wenn alle Seiten geladen sind
+    prefault_willneed, // MADV_WILLNEED: Readahead im Hintergrund anstoßen, mmap kehrt sofort zurück
+    prefault_parallel, // prefault_threads Threads berühren vorab jede Seite
+    prefault_thp       // in anonymen Speicher mit Transparent Huge Pages lesen (weniger Faults und TLB-Misses)
+};
+
+struct File_config {
+    read_backend backend = read_mmap;
+    unsigned queue_depth = 16;       // read_uring: gleichzeitig laufende Lesezugriffe
+    size_t read_block = 4 << 20;     // read_uring: Bytes pro Lesezugriff
+    prefault_policy prefault = prefault_none;
+    unsigned prefault_threads = 0;   // prefault_parallel/prefault_thp, 0 = alle Kerne
+    bool writable = false;           // read_mmap: Puffer beschreibbar mappen (MAP_PRIVATE), sonst nur lesbar
+};
 
 class File {
 public:
-    File(const std::string& path,bool countLines = false) : filename(make_absolute_path(path)), buffer(nullptr), filesize(0)
+    // useIndexFile: Zeilenindex aus <path>.lidx laden, falls dieser noch zur Datei passt, sonst neu bauen und ablegen.
+    // Die Zeilenzahl ist danach exakt, ein separater Zähldurchlauf entfällt.
+    File(const std::string& path,bool countLines = false, bool useIndexFile = false, const File_config& config = File_config()) : filename(make_absolute_path(path)), buffer(nullptr), filesize(0), line_offsets(nullptr), indexed_lines(0), index_mapping(nullptr), index_mapping_size(0)
     {
-        buffer = mmap_file(filename.c_str(), filesize);
-        if (!buffer) throw std::runtime_error("Konnte Datei nicht mappen: " + filename);
-        if(countLines)
-            lines = count_lines(); // Zeilen zählen, wenn lineMethod aktiviert ist
-        else
-            // Nur die letzte Zeile lesen, wenn lineMethod deaktiviert ist
-            lines = read_number_from_last_line();
+        // Wirft der Konstruktor (Lesefehler, Entpacken, .lidx), läuft ~File nicht: Lese-Thread und Puffer hier freigeben
+        try
+        {
+            if (config.backend == read_uring)
+                start_uring_read(config);
+            else
+            {
+                struct rusage before;
+                getrusage(RUSAGE_SELF, &before);
+                auto start = std::chrono::high_resolution_clock::now();
+                buffer = mmap_file(filename.c_str(), filesize, config.writable, config.prefault == prefault_populate ? MAP_POPULATE : 0);
+                if (buffer && config.prefault != prefault_none)
+                    prefault(config, before, start);
+            }
+            if (!buffer) throw std::runtime_error("Konnte Datei nicht mappen: " + filename);
+
+            wait_range(0, std::min<size_t>(filesize, 4));
+            compression_type compression = detect_compression(buffer, filesize);
+            if (compression != compression_none)
+            {
+                // komprimierte Eingabe: direkt in den Speicher entpacken, keine temporäre Datei
+                wait_all();
+                size_t plain_size = 0;
+                char* plain = decompress_buffer(compression, buffer, filesize, plain_size, std::thread::hardware_concurrency());
+                release_buffer();
+                buffer = plain;
+                filesize = plain_size;
+                heap_buffer = true;
+            }
+
+            if (useIndexFile)
+            {
+                if (!load_line_index_file())
+                {
+                    build_line_index();
+                    store_line_index_file();
+                }
+            }
+            else if(countLines)
+            {
+                wait_all();
+                lines = count_lines(); // Zeilen zählen, wenn lineMethod aktiviert ist
+            }
+            else
+            {
+                wait_all();
+                // Nur die letzte Zeile lesen, wenn lineMethod deaktiviert ist
+                lines = read_number_from_last_line();
+            }
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
         printf("Datei %s gemappt, Größe: %zu Bytes, Zeilenanzahl: %zu\n", filename.c_str(), filesize, lines);
     }
 
     ~File() {
-        if (buffer && filesize > 0)
-            munmap((void*)buffer, filesize);
+        release();
     }
 
     size_t line_count() const { return this->lines; }
+    const size_t* line_index() const { return line_offsets; } // Zeilenanfänge, line_index()[line_count()] == size()
+    bool has_line_index() const { return line_offsets != nullptr; }
     char* data() const { return buffer; }
     size_t size() const { return filesize; }
+
+    // Bei read_uring kommen die Daten im Hintergrund an: vor dem Zugriff auf [begin, end) warten.
+    // Bei read_mmap sofort zurück.
+    void wait_range(size_t begin, size_t end) const
+    {
+        if (!async_read || begin >= end) return;
+        std::unique_lock<std::mutex> lock(async_read->mutex);
+        size_t first = begin / async_read->block_size;
+        size_t last = (end - 1) / async_read->block_size;
+        async_read->ready_cv.wait(lock, [&] {
+            if (!async_read->error.empty()) return true;
+            for (size_t b = first; b <= last; ++b)
+                if (!async_read->block_ready[b]) return false;
+            return true;
+        });
+        if (!async_read->error.empty())
+            throw std::runtime_error("Lesefehler in " + filename + ": " + async_read->error);
+    }
+
+    void wait_all() const { wait_range(0, filesize); }
     const std::string& path() const { return filename; }
 
     // Liest die Zahl am Anfang der letzten Zeile aus
@@ -55,12 +435,157 @@ public:
 
     const size_t count_lines() const 
     {
-        size_t count = 0;
-        for (size_t i = 0; i < filesize; ++i) 
+        return count_newlines(buffer, filesize) + 1; //\0 mit einrechnen
+    }
+
+    // Baut den Zeilenindex parallel auf: jeder Thread zählt die '\n' und die Anführungszeichen seines
+    // Byte-Blocks (scan_quotes). Über das Präfix-XOR der Paritäten kennt danach jeder Block seinen
+    // Anführungszeichen-Zustand am Anfang, über die Präfixsumme der Datensatzenden seine Schreibposition.
+    // Zeilenumbrüche innerhalb von Anführungszeichen beginnen keinen Eintrag, der Index enthält also
+    // Datensatzanfänge. Danach ist line_count() exakt (ohne leere letzte Zeile).
+    void build_line_index(size_t num_threads = std::thread::hardware_concurrency())
+    {
+        if (line_offsets) return;
+
+        size_t max_threads = filesize / min_index_chunk + 1; // kleine Dateien nicht zerstückeln
+        num_threads = std::max<size_t>(1, std::min(num_threads, max_threads));
+
+        size_t* chunk_bounds = new size_t[num_threads + 1];
+        size_t* chunk_lines = new size_t[num_threads + 1];
+        quote_scan* chunk_scans = new quote_scan[num_threads];
+        bool* chunk_quoted = new bool[num_threads];
+        for (size_t t = 0; t < num_threads; ++t)
+            chunk_bounds[t] = filesize / num_threads * t;
+        chunk_bounds[num_threads] = filesize;
+
+        // 1. Zeilenumbrüche und Anführungszeichen pro Block zählen (bei read_uring, sobald der Block gelesen ist)
+        run_on_chunks(num_threads, [&](size_t t) {
+            wait_range(chunk_bounds[t], chunk_bounds[t + 1]);
+            chunk_scans[t] = scan_quotes(buffer + chunk_bounds[t], chunk_bounds[t + 1] - chunk_bounds[t]);
+        });
+
+        // 2. Präfix-XOR der Paritäten und Präfixsumme: Zeile 0 beginnt immer bei Offset 0,
+        //    Block t schreibt ab Index 1 + sum(chunk_lines[0..t-1])
+        size_t total = 1;
+        bool quoted = false;
+        for (size_t t = 0; t < num_threads; ++t)
         {
-            if (buffer[i] == '\n') ++count;
+            const quote_scan& scan = chunk_scans[t];
+            size_t count = quoted ? scan.newlines - scan.record_ends : scan.record_ends;
+            chunk_quoted[t] = quoted;
+            chunk_lines[t] = total;
+            total += count;
+            quoted ^= scan.odd_quotes;
         }
-        return ++count; //\0 mit einrechnen
+
+        line_offsets = new size_t[total + 1];
+        line_offsets[0] = 0;
+
+        // 3. Zeilenanfänge an die vorberechneten Positionen schreiben
+        run_on_chunks(num_threads, [&](size_t t) {
+            collect_record_starts(buffer, chunk_bounds[t], chunk_bounds[t + 1], chunk_quoted[t], line_offsets + chunk_lines[t]);
+        });
+
+        if (total > 1 && line_offsets[total - 1] >= filesize) --total; // abschließendes '\n' beginnt keine neue Zeile
+        line_offsets[total] = filesize;
+        indexed_lines = total;
+        lines = total;
+
+        delete[] chunk_bounds;
+        delete[] chunk_lines;
+        delete[] chunk_scans;
+        delete[] chunk_quoted;
+        printf("Zeilenindex für %s aufgebaut: %zu Zeilen mit %zu Threads\n", filename.c_str(), lines, num_threads);
+    }
+
+    std::string index_file_path() const { return filename + ".lidx"; }
+
+    // Mappt <datei>.lidx, wenn Größe, Änderungszeit und Stichproben-Hash noch zur Datei passen
+    bool load_line_index_file()
+    {
+        if (line_offsets) return true;
+
+        std::string index_path = index_file_path();
+        int fd = open(index_path.c_str(), O_RDONLY);
+        if (fd == -1) return false; // noch kein Index vorhanden
+
+        struct stat sb;
+        if (fstat(fd, &sb) == -1 || (size_t)sb.st_size < sizeof(line_index_header))
+        {
+            close(fd);
+            return false;
+        }
+
+        size_t mapping_size = sb.st_size;
+        void* mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) return false;
+
+        const line_index_header* header = (const line_index_header*)mapping;
+        bool valid = memcmp(header->magic, "DDLIDX", 6) == 0
+                  && header->version == line_index_version
+                  && header->file_size == filesize
+                  && header->mtime_sec == (int64_t)file_mtime.tv_sec
+                  && header->mtime_nsec == (int64_t)file_mtime.tv_nsec
+                  && header->sample_hash == sample_hash()
+                  && mapping_size == sizeof(line_index_header) + (header->line_count + 1) * sizeof(uint64_t);
+        if (!valid)
+        {
+            printf("Zeilenindex %s ist veraltet, wird neu aufgebaut\n", index_path.c_str());
+            munmap(mapping, mapping_size);
+            return false;
+        }
+
+        index_mapping = mapping;
+        index_mapping_size = mapping_size;
+        line_offsets = (size_t*)((char*)mapping + sizeof(line_index_header));
+        indexed_lines = header->line_count;
+        lines = indexed_lines;
+        printf("Zeilenindex %s geladen: %zu Zeilen\n", index_path.c_str(), lines);
+        return true;
+    }
+
+    // Schreibt den aktuellen Zeilenindex nach <datei>.lidx (über eine temporäre Datei + rename,
+    // damit parallel laufende Prozesse nie einen halb geschriebenen Index sehen)
+    bool store_line_index_file() const
+    {
+        if (!line_offsets) return false;
+
+        line_index_header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, "DDLIDX", 6);
+        header.version = line_index_version;
+        header.file_size = filesize;
+        header.mtime_sec = file_mtime.tv_sec;
+        header.mtime_nsec = file_mtime.tv_nsec;
+        header.sample_hash = sample_hash();
+        header.line_count = indexed_lines;
+
+        std::string index_path = index_file_path();
+        std::string tmp_path = index_path + ".tmp." + std::to_string(getpid());
+        FILE* out = fopen(tmp_path.c_str(), "wb");
+        if (!out)
+        {
+            printf("Zeilenindex %s kann nicht geschrieben werden, wird nur im Speicher gehalten\n", index_path.c_str());
+            return false;
+        }
+        bool ok = fwrite(&header, sizeof(header), 1, out) == 1
+               && fwrite(line_offsets, sizeof(uint64_t), indexed_lines + 1, out) == indexed_lines + 1;
+        ok = (fclose(out) == 0) && ok;
+        if (!ok || rename(tmp_path.c_str(), index_path.c_str()) != 0)
+        {
+            perror("store_line_index_file");
+            unlink(tmp_path.c_str());
+            return false;
+        }
+        printf("Zeilenindex %s geschrieben\n", index_path.c_str());
+        return true;
+    }
+
+    // Index der Zeile, die an oder nach Byte-Offset pos beginnt (line_count(), falls keine mehr folgt)
+    size_t line_at_or_after(size_t pos) const
+    {
+        return std::lower_bound(line_offsets, line_offsets + indexed_lines, pos) - line_offsets;
     }
 
     // Gibt einen Zeiger auf den Anfang der letzten Zeile zurück
@@ -72,10 +597,119 @@ public:
     }
 
 private:
+    static constexpr size_t min_index_chunk = 1 << 20; // mindestens 1 MiB pro Index-Thread
+
     std::string filename;
     char* buffer;
     size_t filesize;
     size_t lines;
+    size_t* line_offsets; // indexed_lines + 1 Einträge, letzter == filesize
+    size_t indexed_lines;
+    bool heap_buffer = false; // entpackte Daten liegen in new[] statt in einem Mapping
+    size_t mapping_size = 0;  // Größe des Mappings ab buffer (Datei + Leseüberhang, bei prefault_thp der anonyme Puffer)
+    void* index_mapping;  // gesetzt, wenn line_offsets aus einer .lidx-Datei gemappt ist
+    size_t index_mapping_size;
+    struct timespec file_mtime;
+
+    // Zustand des Hintergrund-Lesens bei read_uring
+    struct async_read_state {
+        std::thread reader;
+        std::mutex mutex;
+        std::condition_variable ready_cv;
+        size_t block_size = 0;
+        std::vector<uint8_t> block_ready;
+        std::string error;
+    };
+    std::unique_ptr<async_read_state> async_read;
+
+    static constexpr size_t hash_sample_bytes = 64 * 1024;
+
+    // Legt den Puffer an und startet den Lese-Thread; data() ist danach blockweise über wait_range verfügbar
+    void start_uring_read(const File_config& config)
+    {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd == -1) throw std::runtime_error("Konnte Datei nicht öffnen: " + filename);
+        struct stat sb;
+        if (fstat(fd, &sb) == -1 || sb.st_size == 0)
+        {
+            close(fd);
+            throw std::runtime_error("Datei ist leer oder nicht lesbar: " + filename);
+        }
+        filesize = sb.st_size;
+        file_mtime = sb.st_mtim;
+
+        buffer = new char[filesize + decompress_padding];
+        memset(buffer + filesize, 0, decompress_padding);
+        heap_buffer = true;
+
+        async_read = std::make_unique<async_read_state>();
+        async_read->block_size = std::min<size_t>(std::max<size_t>(config.read_block, 4096), 1u << 30);
+        async_read->block_ready.assign((filesize + async_read->block_size - 1) / async_read->block_size, 0);
+        unsigned queue_depth = config.queue_depth;
+        async_read_state* state = async_read.get();
+        char* dst = buffer;
+        size_t size = filesize;
+        std::string name = filename;
+        state->reader = std::thread([state, fd, dst, size, queue_depth, name]() {
+            auto start = std::chrono::high_resolution_clock::now();
+            Uring_reader ring(queue_depth);
+            try
+            {
+                ring.read_file(fd, dst, size, state->block_size, [state](size_t begin, size_t) {
+                    {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        state->block_ready[begin / state->block_size] = 1;
+                    }
+                    state->ready_cv.notify_all();
+                });
+            }
+            catch (const std::exception& e)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->error = e.what();
+            }
+            close(fd);
+            state->ready_cv.notify_all();
+            double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            printf("%s: %zu Bytes mit %s (Queue-Tiefe %u) in %.3f s gelesen\n", name.c_str(), size, ring.available() ? "io_uring" : "pread", ring.queue_depth(), seconds);
+        });
+    }
+
+    // FNV-1a über die ersten und letzten 64 KiB: erkennt zusammen mit Größe und mtime
+    // ausgetauschte Dateien, ohne die ganze Datei lesen zu müssen
+    uint64_t sample_hash() const
+    {
+        wait_range(0, std::min(filesize, hash_sample_bytes));
+        wait_range(filesize > hash_sample_bytes ? filesize - hash_sample_bytes : 0, filesize);
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                hash ^= (unsigned char)buffer[i];
+                hash *= 1099511628211ull;
+            }
+        };
+        size_t head_end = std::min(filesize, hash_sample_bytes);
+        mix(0, head_end);
+        mix(std::max(head_end, filesize > hash_sample_bytes ? filesize - hash_sample_bytes : 0), filesize);
+        return hash;
+    }
+
+    template <typename F>
+    static void run_on_chunks(size_t num_threads, F&& work)
+    {
+        if (num_threads == 1)
+        {
+            work(0);
+            return;
+        }
+        std::thread* threads = new std::thread[num_threads];
+        for (size_t t = 0; t < num_threads; ++t)
+            threads[t] = std::thread([&work, t]() { work(t); });
+        for (size_t t = 0; t < num_threads; ++t)
+            threads[t].join();
+        delete[] threads;
+    }
 
     std::string make_absolute_path(const std::string& rel_path) {
         try {
@@ -85,7 +719,96 @@ private:
         }
     }
 
-    char* mmap_file(const char* filename, size_t& filesize) {
+    // Wartet auf den Lese-Thread und gibt Puffer und Zeilenindex frei
+    void release()
+    {
+        if (async_read && async_read->reader.joinable())
+            async_read->reader.join(); // laufende Lesezugriffe schreiben noch in buffer
+        release_buffer();
+        if (index_mapping)
+            munmap(index_mapping, index_mapping_size);
+        else
+            delete[] line_offsets;
+        index_mapping = nullptr;
+        line_offsets = nullptr;
+    }
+
+    void release_buffer()
+    {
+        if (heap_buffer)
+            delete[] buffer;
+        else if (mapping_size)
+            munmap((void*)buffer, mapping_size);
+        buffer = nullptr;
+        heap_buffer = false;
+        mapping_size = 0;
+    }
+
+    // Lädt die gemappten Seiten nach der gewählten Policy vorab und gibt Zeit und Page Faults
+    // seit before/start (vor dem mmap, damit MAP_POPULATE mitgemessen wird) aus
+    void prefault(const File_config& config, const struct rusage& before, std::chrono::high_resolution_clock::time_point start)
+    {
+        static const char* policy_names[] = {"none", "populate", "willneed", "parallel", "thp"};
+        size_t num_threads = config.prefault_threads ? config.prefault_threads : std::max(1u, std::thread::hardware_concurrency());
+        struct rusage after;
+
+        const size_t page = sysconf(_SC_PAGESIZE);
+        switch (config.prefault)
+        {
+            case prefault_willneed:
+                madvise(buffer, filesize, MADV_WILLNEED);
+                break;
+            case prefault_parallel:
+                // lesend berühren; bei beschreibbarem Mapping schreibend, damit die private Kopie (MAP_PRIVATE)
+                // schon hier entsteht und nicht erst beim ersten Schreibzugriff in der Parse-Schleife
+                parallel_for_each_index(num_threads, num_threads, [&](size_t t) {
+                    size_t pages = (filesize + page - 1) / page;
+                    volatile char* p = buffer;
+                    for (size_t i = pages * t / num_threads; i < pages * (t + 1) / num_threads; ++i)
+                    {
+                        if (config.writable)
+                            p[i * page] = p[i * page];
+                        else
+                            (void)p[i * page];
+                    }
+                });
+                break;
+            case prefault_thp:
+            {
+                const size_t huge_page = 2 << 20;
+                size_t huge_size = (filesize + decompress_padding + huge_page - 1) / huge_page * huge_page;
+                char* anon = (char*)mmap(nullptr, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (anon == MAP_FAILED)
+                {
+                    perror("mmap (thp)");
+                    break;
+                }
+                madvise(anon, huge_size, MADV_HUGEPAGE);
+                parallel_for_each_index(num_threads, num_threads, [&](size_t t) {
+                    size_t begin = filesize / huge_page * t / num_threads * huge_page;
+                    size_t end = t + 1 == num_threads ? filesize : filesize / huge_page * (t + 1) / num_threads * huge_page;
+                    if (begin < end)
+                        memcpy(anon + begin, buffer + begin, end - begin);
+                });
+                munmap((void*)buffer, mapping_size);
+                buffer = anon;
+                mapping_size = huge_size;
+                break;
+            }
+            default:
+                break;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        getrusage(RUSAGE_SELF, &after);
+        printf("Prefault %s für %s: %.3f s, %ld minor / %ld major Faults\n", policy_names[config.prefault], filename.c_str(), seconds,
+               after.ru_minflt - before.ru_minflt, after.ru_majflt - before.ru_majflt);
+    }
+
+    // Mappt die Datei (nur lesbar, außer writable) in einen reservierten Bereich, der mindestens eine Seite
+    // über das Dateiende hinausgeht: Lesezugriffe hinter dem letzten Byte (Terminator, Wortzugriffe der
+    // Parser) treffen so immer auf Nullbytes, auch wenn die Dateigröße ein Vielfaches der Seitengröße ist.
+    char* mmap_file(const char* filename, size_t& filesize, bool writable, int extra_flags = 0) {
         int fd = open(filename, O_RDONLY);
         if (fd == -1) {
             perror("open");
@@ -99,17 +822,29 @@ private:
             return nullptr;
         }
         filesize = sb.st_size;
+        file_mtime = sb.st_mtim;
         if (filesize == 0) {
             fprintf(stderr, "Datei ist leer!\n");
             close(fd);
             return nullptr;
         }
 
-        char* data = (char*)mmap(nullptr, filesize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        const size_t page = sysconf(_SC_PAGESIZE);
+        size_t reserved = (filesize + page - 1) / page * page + page;
+        char* data = (char*)mmap(nullptr, reserved, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data != MAP_FAILED) {
+            int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+            if (mmap(data, filesize, prot, MAP_PRIVATE | MAP_FIXED | extra_flags, fd, 0) == MAP_FAILED) {
+                munmap(data, reserved);
+                data = (char*)MAP_FAILED;
+            }
+        }
         if (data == MAP_FAILED) {
             perror("mmap");
             data = nullptr;
         }
+        else
+            mapping_size = reserved;
         close(fd);
         return data;
     }
@@ -117,4 +852,408 @@ private:
 
 
 
+// Mehrere CSV-Shards, die zusammen ein Dataset bilden (z.B. "../data/laptops_*.csv" oder "a.csv,b.csv").
+// Die Shards werden parallel gemappt und indiziert; Parser_mngr::parse_multithreaded(File_set&) parst
+// sie parallel in ein gemeinsames dataSet. Die Datensatz-ID ist wie bei einer einzelnen Datei der Index
+// im dataSet, d.h. Shard i belegt die IDs [record_base(i), record_base(i + 1)) in der Reihenfolge der Shards.
+class File_set {
+public:
+    // pattern: Glob-Muster oder durch ',' getrennte Liste (Einträge dürfen selbst Muster sein).
+    // Treffer eines Musters werden sortiert, die Reihenfolge der Liste bleibt erhalten.
+    File_set(const std::string& pattern, bool useIndexFile = true, const File_config& config = File_config()) : File_set(expand_pattern(pattern), useIndexFile, config) {}
+
+    File_set(const std::vector<std::string>& paths, bool useIndexFile = true, const File_config& config = File_config()) : shards(paths.size(), nullptr), record_bases(paths.size() + 1, 0)
+    {
+        if (paths.empty()) throw std::runtime_error("File_set ohne Dateien");
+
+        std::vector<std::string> errors(paths.size());
+        parallel_for_each_index(paths.size(), std::thread::hardware_concurrency(), [&](size_t i) {
+            try
+            {
+                shards[i] = new File(paths[i], false, useIndexFile, config);
+            }
+            catch (const std::exception& e)
+            {
+                errors[i] = e.what();
+            }
+        });
+        for (const std::string& error : errors)
+        {
+            if (!error.empty())
+            {
+                release();
+                throw std::runtime_error(error);
+            }
+        }
+        printf("%zu Shards gemappt\n", shards.size());
+    }
+
+    ~File_set() { release(); }
+
+    File_set(const File_set&) = delete;
+    File_set& operator=(const File_set&) = delete;
+
+    size_t shard_count() const { return shards.size(); }
+    File& shard(size_t i) { return *shards[i]; }
+
+    // Erste globale ID des Shards i (gesetzt beim Parsen); record_base(shard_count()) == Gesamtzahl
+    size_t record_base(size_t i) const { return record_bases[i]; }
+    void set_record_bases(const std::vector<size_t>& bases) { record_bases = bases; }
+
+    // Shard, aus dem die globale ID stammt
+    size_t shard_of(size_t id) const
+    {
+        return std::upper_bound(record_bases.begin(), record_bases.end(), id) - record_bases.begin() - 1;
+    }
+
+    // true, wenn path als File_set gelesen werden muss (Glob-Zeichen oder Liste)
+    static bool is_pattern(const std::string& path)
+    {
+        return path.find_first_of("*?[,") != std::string::npos;
+    }
+
+    static std::vector<std::string> expand_pattern(const std::string& pattern)
+    {
+        std::vector<std::string> paths;
+        std::stringstream list(pattern);
+        std::string entry;
+        while (std::getline(list, entry, ','))
+        {
+            if (entry.empty()) continue;
+            glob_t matches;
+            if (glob(entry.c_str(), 0, nullptr, &matches) == 0)
+            {
+                for (size_t i = 0; i < matches.gl_pathc; ++i) // glob liefert sortiert
+                    paths.push_back(matches.gl_pathv[i]);
+            }
+            else if (entry.find_first_of("*?[") == std::string::npos)
+                paths.push_back(entry); // einzelne Datei: Fehlermeldung kommt von File
+            globfree(&matches);
+        }
+        if (paths.empty()) throw std::runtime_error("Keine Dateien gefunden für: " + pattern);
+        return paths;
+    }
+
+private:
+    void release()
+    {
+        for (File* file : shards)
+            delete file;
+        shards.clear();
+    }
+
+    std::vector<File*> shards;
+    std::vector<size_t> record_bases;
+};
+
+
+
+// Liest eine Datei blockweise mit pread, statt sie komplett zu mappen. Es ist immer nur ein Fenster
+// von window_bytes resident; jeder Block endet auf einem Datensatzende (Anführungszeichen werden beachtet)
+// und ist nullterminiert, damit der Parser wie auf der gemappten Datei arbeiten kann. Die Texte der
+// Datensätze schreibt der Parser ohnehin in seine String-Arenen, das Fenster wird also sofort wiederverwendet.
+//
+// Pfad "-" (stdin) oder eine FIFO lässt sich weder mappen noch mit pread lesen. Dann liest ein eigener
+// Thread mit read() abwechselnd in zwei Puffer (je window_bytes): während der Parser den einen Block
+// verarbeitet, füllt der Thread schon den nächsten. Wartet der Parser, wird der Block schon beim ersten
+// vollständigen Datensatz übergeben, damit das Einlesen mit dem Erzeuger der Daten überlappt.
+// record_quote: '"' bei CSV/TSV, '\0' bei JSONL (jedes '\n' beendet einen Datensatz, siehe record_quote in Utillity.h).
+class File_stream {
+public:
+    static constexpr size_t default_window = 64 << 20; // 64 MiB
+    static constexpr size_t window_padding = 64;
+
+    File_stream(const std::string& path, size_t window_bytes = default_window, char record_quote = '"') : window_capacity(std::max<size_t>(window_bytes, 4096)), record_quote(record_quote)
+    {
+        if (path == "-")
+        {
+            filename = "stdin";
+            fd = STDIN_FILENO;
+            owns_fd = false;
+        }
+        else
+        {
+            filename = std::filesystem::absolute(path).string();
+            fd = open(filename.c_str(), O_RDONLY);
+            if (fd == -1) throw std::runtime_error("Konnte Datei nicht öffnen: " + filename);
+        }
+
+        struct stat sb;
+        if (fstat(fd, &sb) == -1)
+        {
+            if (owns_fd) close(fd);
+            throw std::runtime_error("Konnte Dateigröße nicht lesen: " + filename);
+        }
+
+        if (!S_ISREG(sb.st_mode))
+        {
+            pipe_mode = true;
+            if (pipe2(stop_pipe, O_CLOEXEC) == -1)
+            {
+                if (owns_fd) close(fd);
+                throw std::runtime_error("Konnte Stop-Pipe für den Lese-Thread nicht anlegen: " + filename);
+            }
+            for (int slot = 0; slot < 2; ++slot)
+            {
+                pipe_buffer[slot] = new char[window_capacity + window_padding]();
+                pipe_capacity[slot] = window_capacity;
+            }
+            reader = std::thread(&File_stream::pipe_reader, this);
+            printf("%s wird über einen Lese-Thread gestreamt, Puffer: 2 x %zu Bytes\n", filename.c_str(), window_capacity);
+            return;
+        }
+
+        filesize = sb.st_size;
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        window = new char[window_capacity + window_padding](); // Terminator + Leseüberhang der Parser
+        printf("Datei %s wird gestreamt, Größe: %zu Bytes, Fenster: %zu Bytes\n", filename.c_str(), filesize, window_capacity);
+    }
+
+    ~File_stream()
+    {
+        if (pipe_mode)
+        {
+            // der Lese-Thread wartet ggf. in poll() auf den Erzeuger: das Schließen der Stop-Pipe weckt ihn auf,
+            // auch wenn der Erzeuger die Pipe offen hält und nichts mehr schreibt
+            {
+                std::lock_guard<std::mutex> lock(pipe_mutex);
+                stop_reader = true;
+            }
+            pipe_cv.notify_all();
+            close(stop_pipe[1]);
+            reader.join();
+            close(stop_pipe[0]);
+            delete[] pipe_buffer[0];
+            delete[] pipe_buffer[1];
+        }
+        if (owns_fd) close(fd);
+        delete[] window;
+    }
+
+    // Nächster Block aus vollständigen Datensätzen, gültig bis zum nächsten Aufruf. nullptr am Dateiende.
+    char* next_block(size_t& block_size)
+    {
+        if (pipe_mode)
+            return next_pipe_block(block_size);
+
+        // Rest hinter dem letzten Block (angefangener Datensatz) an den Fensteranfang schieben
+        if (block_end > 0)
+        {
+            window[block_end] = saved_char;
+            memmove(window, window + block_end, filled - block_end);
+            filled -= block_end;
+            block_end = 0;
+        }
+
+        while (true)
+        {
+            while (filled < window_capacity && read_pos < filesize)
+            {
+                ssize_t n = pread(fd, window + filled, window_capacity - filled, read_pos);
+                if (n < 0) throw std::runtime_error("Lesefehler in: " + filename);
+                if (n == 0) break;
+                filled += n;
+                read_pos += n;
+            }
+            if (filled == 0) return nullptr;
+
+            size_t end = read_pos >= filesize ? filled : last_record_end(window, filled, record_quote);
+            if (end > 0)
+            {
+                // bereits vollständig gelesene Seiten aus dem Page-Cache werfen
+                size_t consumed = read_pos - filled;
+                if (consumed > dropped_until)
+                {
+                    posix_fadvise(fd, dropped_until, consumed - dropped_until, POSIX_FADV_DONTNEED);
+                    dropped_until = consumed;
+                }
+
+                block_end = end;
+                saved_char = window[end];
+                window[end] = '\0';
+                block_size = end;
+                return window;
+            }
+
+            // ein einzelner Datensatz ist größer als das Fenster -> Fenster verdoppeln
+            char* grown = new char[window_capacity * 2 + window_padding]();
+            memcpy(grown, window, filled);
+            delete[] window;
+            window = grown;
+            window_capacity *= 2;
+            printf("Fenster für %s auf %zu Bytes vergrößert\n", filename.c_str(), window_capacity);
+        }
+    }
+
+    // Bei Pipes die Anzahl der bisher gelesenen Bytes
+    size_t size() const { return pipe_mode ? pipe_bytes_read.load() : filesize; }
+    const std::string& path() const { return filename; }
+
+private:
+    // Gibt den zuletzt verliehenen Puffer an den Lese-Thread zurück und wartet auf den nächsten
+    char* next_pipe_block(size_t& block_size)
+    {
+        std::unique_lock<std::mutex> lock(pipe_mutex);
+        if (lent_slot >= 0)
+        {
+            pipe_ready[lent_slot] = false;
+            lent_slot = -1;
+            pipe_cv.notify_all();
+        }
+
+        consumer_waiting = true;
+        pipe_cv.wait(lock, [&] { return pipe_ready[next_slot] || reader_done; });
+        consumer_waiting = false;
+
+        if (!pipe_ready[next_slot])
+        {
+            if (reader_error) std::rethrow_exception(reader_error);
+            return nullptr;
+        }
+        lent_slot = next_slot;
+        next_slot ^= 1;
+        block_size = pipe_block_size[lent_slot];
+        return pipe_buffer[lent_slot];
+    }
+
+    // Lese-Thread: füllt abwechselnd beide Puffer, der angefangene Datensatz am Ende wandert in den nächsten
+    void pipe_reader()
+    {
+        std::vector<char> carry;
+        int slot = 0;
+        bool eof = false;
+        bool stopped = false;
+        while (!eof)
+        {
+            {
+                std::unique_lock<std::mutex> lock(pipe_mutex);
+                pipe_cv.wait(lock, [&] { return !pipe_ready[slot] || stop_reader; });
+                if (stop_reader) break;
+            }
+
+            char* buf = pipe_buffer[slot];
+            if (carry.size() >= pipe_capacity[slot])
+            {
+                // der andere Puffer wurde für einen langen Datensatz vergrößert
+                while (carry.size() >= pipe_capacity[slot])
+                    pipe_capacity[slot] *= 2;
+                delete[] buf;
+                buf = new char[pipe_capacity[slot] + window_padding]();
+                std::lock_guard<std::mutex> lock(pipe_mutex);
+                pipe_buffer[slot] = buf;
+            }
+            size_t filled = carry.size();
+            memcpy(buf, carry.data(), filled);
+            size_t end = 0;
+            try
+            {
+                while (true)
+                {
+                    if (filled == pipe_capacity[slot])
+                    {
+                        // ein einzelner Datensatz ist größer als der Puffer -> Puffer verdoppeln
+                        char* grown = new char[pipe_capacity[slot] * 2 + window_padding]();
+                        memcpy(grown, buf, filled);
+                        delete[] buf;
+                        buf = grown;
+                        pipe_capacity[slot] *= 2;
+                        std::lock_guard<std::mutex> lock(pipe_mutex);
+                        pipe_buffer[slot] = buf;
+                    }
+
+                    // erst lesen, wenn Daten da sind oder der Destruktor die Stop-Pipe geschlossen hat
+                    pollfd wait_for[2] = {{fd, POLLIN, 0}, {stop_pipe[0], POLLIN, 0}};
+                    if (poll(wait_for, 2, -1) < 0)
+                    {
+                        if (errno == EINTR) continue;
+                        throw std::runtime_error("Lesefehler in: " + filename);
+                    }
+                    if (wait_for[1].revents)
+                    {
+                        stopped = true;
+                        break;
+                    }
+
+                    ssize_t n = read(fd, buf + filled, pipe_capacity[slot] - filled);
+                    if (n < 0 && errno == EINTR) continue;
+                    if (n < 0) throw std::runtime_error("Lesefehler in: " + filename);
+                    if (n == 0)
+                    {
+                        eof = true;
+                        end = filled;
+                        break;
+                    }
+                    bool new_line = memchr(buf + filled, '\n', n) != nullptr;
+                    filled += n;
+                    pipe_bytes_read += n;
+
+                    // übergeben, wenn der Puffer voll ist oder der Parser schon wartet
+                    if (filled == pipe_capacity[slot] || (new_line && consumer_waiting))
+                    {
+                        end = last_record_end(buf, filled, record_quote);
+                        if (end > 0) break;
+                    }
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(pipe_mutex);
+                reader_error = std::current_exception();
+                break;
+            }
+            if (stopped)
+                break;
+
+            carry.assign(buf + end, buf + filled);
+            buf[end] = '\0';
+            if (end > 0)
+            {
+                std::lock_guard<std::mutex> lock(pipe_mutex);
+                pipe_block_size[slot] = end;
+                pipe_ready[slot] = true;
+            }
+            pipe_cv.notify_all();
+            slot ^= 1;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pipe_mutex);
+            reader_done = true;
+        }
+        pipe_cv.notify_all();
+    }
+
+    std::string filename;
+    int fd = -1;
+    bool owns_fd = true;
+    size_t filesize = 0;
+    size_t read_pos = 0;      // nächster Lese-Offset in der Datei
+    size_t dropped_until = 0; // bis hier wurde der Page-Cache bereits freigegeben
+    char* window = nullptr;
+    size_t window_capacity;
+    size_t filled = 0;        // gültige Bytes im Fenster
+    size_t block_end = 0;     // Ende des zuletzt ausgegebenen Blocks
+    char saved_char = 0;      // durch den Terminator überschriebenes Byte
+    char record_quote;        // Anführungszeichen für Datensatzgrenzen ('\0': jedes '\n')
+
+    // Pipe-Modus (stdin/FIFO): Doppelpuffer, befüllt vom Lese-Thread
+    bool pipe_mode = false;
+    std::thread reader;
+    std::mutex pipe_mutex;
+    std::condition_variable pipe_cv;
+    char* pipe_buffer[2] = {nullptr, nullptr};
+    size_t pipe_capacity[2] = {0, 0};
+    size_t pipe_block_size[2] = {0, 0};
+    bool pipe_ready[2] = {false, false}; // Block liegt bereit bzw. ist an den Parser verliehen
+    int next_slot = 0;
+    int lent_slot = -1;
+    bool reader_done = false;
+    bool stop_reader = false;
+    int stop_pipe[2] = {-1, -1}; // Schreibende wird im Destruktor geschlossen und weckt den Lese-Thread
+    std::atomic<bool> consumer_waiting{false};
+    std::atomic<size_t> pipe_bytes_read{0};
+    std::exception_ptr reader_error;
+};
+
 #endif //DUPLICATEDETECTION_FILEINPUT_H
@@ -0,0 +1,301 @@
+#ifndef OUTPUT_MNGR_H
+#define OUTPUT_MNGR_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <charconv>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "DataTypes.h"
+#include "Result_file.h"
+
+// Schreibt die gefundenen Matches (dataSet<matching> aus Matching_mngr::identify_matches) in eine Datei.
+// Jeder Thread formatiert einen gleich großen Teil der Matches in seinen eigenen Puffer (std::to_chars,
+// kein printf/Locale), danach landen alle Puffer in Thread-Reihenfolge mit einem pwritev in der Datei.
+// Das Formatieren skaliert mit den Threads, der Schreibzugriff ist ein einziger Syscall.
+//
+// Formate:
+//   output_csv:    Kopfzeile "lid,rid,score", danach eine Zeile pro Match in Partitionsreihenfolge
+//   output_binary: versioniertes Ergebnisformat aus Result_file.h (Header, sortierte eindeutige
+//                  match_record, optional Cluster = Zusammenhangskomponenten der Matches)
+class Output_mngr
+{
+public:
+    enum output_format {
+        output_csv,
+        output_binary
+    };
+
+    // Längste CSV-Zeile: zwei 20-stellige IDs, kürzeste Darstellung eines double (max. 24 Zeichen), Trenner
+    static constexpr size_t max_csv_line = 20 + 1 + 20 + 1 + 24 + 1;
+
+    // ".bin" wird binär geschrieben, alles andere als CSV
+    static output_format format_from_path(const std::string& path)
+    {
+        return path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0 ? output_binary : output_csv;
+    }
+
+    // Schreibt alle Matches nach path und gibt die Anzahl geschriebener Bytes zurück.
+    // with_clusters: nur output_binary, hängt die Cluster-Tabellen an.
+    static size_t write_matches(const std::string& path, const dataSet<matching>* matches, output_format format, size_t num_threads, bool with_clusters = false)
+    {
+        // Präfixsummen über die Partitionen: Match k liegt in der Partition p mit offsets[p] <= k < offsets[p + 1]
+        std::vector<size_t> offsets(matches->size + 1, 0);
+        for (size_t p = 0; p < matches->size; ++p)
+            offsets[p + 1] = offsets[p] + matches->data[p].size;
+        size_t total = offsets[matches->size];
+
+        num_threads = std::max<size_t>(1, std::min(num_threads, total / 4096 + 1));
+
+        if (format == output_binary)
+            return write_result_file(path, matches, offsets, num_threads, with_clusters);
+
+        std::vector<std::vector<char>> buffers(num_threads);
+        std::vector<size_t> used(num_threads, 0);
+        run_threads(num_threads, [&](size_t t) {
+            size_t begin = total * t / num_threads;
+            size_t end = total * (t + 1) / num_threads;
+            buffers[t].resize((end - begin) * max_csv_line);
+            char* out = buffers[t].data();
+            for_each_match(matches, offsets, begin, end, [&](const match& m) { out = format_csv_line(out, m); });
+            used[t] = out - buffers[t].data();
+        });
+
+        static const char csv_header[] = "lid,rid,score\n";
+        std::vector<iovec> parts;
+        parts.push_back({(void*)csv_header, sizeof(csv_header) - 1});
+        for (size_t t = 0; t < num_threads; ++t)
+            if (used[t])
+                parts.push_back({buffers[t].data(), used[t]});
+
+        size_t written = write_all(path, parts);
+        printf("%zu Matches nach %s geschrieben (CSV, %zu Bytes, %zu Threads)\n", total, path.c_str(), written, num_threads);
+        return written;
+    }
+
+private:
+    template <typename F>
+    static void run_threads(size_t num_threads, F&& work)
+    {
+        if (num_threads == 1)
+        {
+            work(0);
+            return;
+        }
+        std::thread* threads = new std::thread[num_threads];
+        for (size_t t = 0; t < num_threads; ++t)
+            threads[t] = std::thread([&work, t]() { work(t); });
+        for (size_t t = 0; t < num_threads; ++t)
+            threads[t].join();
+        delete[] threads;
+    }
+
+    // Ruft visit für die Matches [begin, end) in Partitionsreihenfolge auf
+    template <typename F>
+    static void for_each_match(const dataSet<matching>* matches, const std::vector<size_t>& offsets, size_t begin, size_t end, F&& visit)
+    {
+        size_t p = std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1;
+        for (size_t k = begin; k < end; ++k)
+        {
+            while (k >= offsets[p + 1])
+                ++p;
+            visit(matches->data[p].matches[k - offsets[p]]);
+        }
+    }
+
+    static bool record_less(const match_record& l, const match_record& r)
+    {
+        return l.id_a != r.id_a ? l.id_a < r.id_a : l.id_b < r.id_b;
+    }
+
+    // Sortiert Blöcke parallel und führt sie paarweise zusammen (log2(num_threads) Runden)
+    static void parallel_sort(std::vector<match_record>& records, size_t num_threads)
+    {
+        size_t n = records.size();
+        std::vector<size_t> bounds(num_threads + 1);
+        for (size_t t = 0; t <= num_threads; ++t)
+            bounds[t] = n * t / num_threads;
+        run_threads(num_threads, [&](size_t t) { std::sort(records.begin() + bounds[t], records.begin() + bounds[t + 1], record_less); });
+        for (size_t width = 1; width < num_threads; width *= 2)
+        {
+            size_t merges = (num_threads + 2 * width - 1) / (2 * width);
+            run_threads(merges, [&](size_t m) {
+                size_t first = m * 2 * width;
+                size_t middle = std::min(first + width, num_threads);
+                size_t last = std::min(first + 2 * width, num_threads);
+                if (middle < last)
+                    std::inplace_merge(records.begin() + bounds[first], records.begin() + bounds[middle], records.begin() + bounds[last], record_less);
+            });
+        }
+    }
+
+    // Zusammenhangskomponenten der (sortierten, eindeutigen) Matches mit Union-Find. Cluster sind nach
+    // kleinster ID sortiert, ihre IDs aufsteigend; cluster_offsets hat cluster_count + 1 Einträge.
+    static void build_clusters(const std::vector<match_record>& records, std::vector<uint64_t>& cluster_offsets, std::vector<uint64_t>& members)
+    {
+        std::vector<uint64_t> ids;
+        ids.reserve(records.size() * 2);
+        for (const match_record& r : records)
+        {
+            ids.push_back(r.id_a);
+            ids.push_back(r.id_b);
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        auto index_of = [&](uint64_t id) { return std::lower_bound(ids.begin(), ids.end(), id) - ids.begin(); };
+
+        std::vector<size_t> parent(ids.size());
+        for (size_t i = 0; i < parent.size(); ++i)
+            parent[i] = i;
+        auto find = [&](size_t i) {
+            while (parent[i] != i)
+                i = parent[i] = parent[parent[i]];
+            return i;
+        };
+        for (const match_record& r : records)
+        {
+            size_t a = find(index_of(r.id_a));
+            size_t b = find(index_of(r.id_b));
+            if (a != b)
+                parent[std::max(a, b)] = std::min(a, b); // Wurzel ist immer die kleinste ID der Komponente
+        }
+
+        // Wurzel -> Clusternummer in Reihenfolge der kleinsten ID, dann Mitglieder per Counting Sort
+        std::vector<size_t> cluster_of(ids.size());
+        std::vector<uint64_t> sizes;
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            size_t root = find(i);
+            if (root == i)
+            {
+                cluster_of[i] = sizes.size();
+                sizes.push_back(0);
+            }
+            else
+                cluster_of[i] = cluster_of[root];
+            ++sizes[cluster_of[i]];
+        }
+        cluster_offsets.assign(sizes.size() + 1, 0);
+        for (size_t c = 0; c < sizes.size(); ++c)
+            cluster_offsets[c + 1] = cluster_offsets[c] + sizes[c];
+        members.resize(ids.size());
+        std::vector<uint64_t> fill(cluster_offsets.begin(), cluster_offsets.end() - 1);
+        for (size_t i = 0; i < ids.size(); ++i)
+            members[fill[cluster_of[i]]++] = ids[i];
+    }
+
+    static size_t write_result_file(const std::string& path, const dataSet<matching>* matches, const std::vector<size_t>& offsets, size_t num_threads, bool with_clusters)
+    {
+        // 1. Matches parallel als (kleinere ID, größere ID, Score) einsammeln und sortieren
+        size_t total = offsets.back();
+        std::vector<match_record> records(total);
+        run_threads(num_threads, [&](size_t t) {
+            size_t k = total * t / num_threads;
+            for_each_match(matches, offsets, k, total * (t + 1) / num_threads, [&](const match& m) {
+                uint64_t a = m.data[0], b = m.data[1];
+                records[k++] = {std::min(a, b), std::max(a, b), m.jaccard_index};
+            });
+        });
+        parallel_sort(records, num_threads);
+
+        // 2. Paare aus mehreren Partitionen nur einmal, mit dem höchsten Score
+        size_t unique = 0;
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            if (unique && records[unique - 1].id_a == records[i].id_a && records[unique - 1].id_b == records[i].id_b)
+                records[unique - 1].score = std::max(records[unique - 1].score, records[i].score);
+            else
+                records[unique++] = records[i];
+        }
+        records.resize(unique);
+
+        std::vector<uint64_t> cluster_offsets;
+        std::vector<uint64_t> members;
+        if (with_clusters)
+            build_clusters(records, cluster_offsets, members);
+
+        // 3. Header + Tabellen mit einem pwritev
+        result_header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, result_magic, sizeof(result_magic));
+        header.version = result_version;
+        header.flags = with_clusters ? (uint32_t)result_has_clusters : 0u;
+        header.match_count = records.size();
+        header.matches_offset = sizeof(result_header);
+        if (with_clusters)
+        {
+            header.cluster_count = cluster_offsets.size() - 1;
+            header.cluster_offsets_offset = header.matches_offset + records.size() * sizeof(match_record);
+            header.cluster_members_offset = header.cluster_offsets_offset + cluster_offsets.size() * sizeof(uint64_t);
+            header.member_count = members.size();
+        }
+
+        std::vector<iovec> parts = {{&header, sizeof(header)}, {records.data(), records.size() * sizeof(match_record)}};
+        if (with_clusters)
+        {
+            parts.push_back({cluster_offsets.data(), cluster_offsets.size() * sizeof(uint64_t)});
+            parts.push_back({members.data(), members.size() * sizeof(uint64_t)});
+        }
+        size_t written = write_all(path, parts);
+        printf("%zu Matches (%zu eindeutig, %llu Cluster) nach %s geschrieben (binär v%u, %zu Bytes, %zu Threads)\n", total, records.size(),
+               (unsigned long long)header.cluster_count, path.c_str(), result_version, written, num_threads);
+        return written;
+    }
+
+    static char* format_csv_line(char* out, const match& m)
+    {
+        char* end = out + max_csv_line;
+        out = std::to_chars(out, end, (uint64_t)m.data[0]).ptr;
+        *out++ = ',';
+        out = std::to_chars(out, end, (uint64_t)m.data[1]).ptr;
+        *out++ = ',';
+        out = std::to_chars(out, end, m.jaccard_index).ptr;
+        *out++ = '\n';
+        return out;
+    }
+
+    // Ein pwritev für alle Puffer; nur bei mehr als IOV_MAX Teilen oder einem kurzen Write sind es mehrere
+    static size_t write_all(const std::string& path, std::vector<iovec>& parts)
+    {
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1)
+            throw std::runtime_error("Konnte Ausgabedatei nicht öffnen: " + path + " (" + strerror(errno) + ")");
+
+        size_t offset = 0;
+        size_t first = 0;
+        while (first < parts.size())
+        {
+            int count = (int)std::min<size_t>(parts.size() - first, IOV_MAX);
+            ssize_t n = pwritev(fd, parts.data() + first, count, offset);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n < 0)
+            {
+                std::string error = strerror(errno);
+                close(fd);
+                throw std::runtime_error("pwritev " + path + ": " + error);
+            }
+            offset += n;
+            // vollständig geschriebene Teile überspringen, den angefangenen kürzen
+            while (n > 0 && first < parts.size())
+            {
+                size_t step = std::min<size_t>(n, parts[first].iov_len);
+                parts[first].iov_base = (char*)parts[first].iov_base + step;
+                parts[first].iov_len -= step;
+                n -= step;
+                if (parts[first].iov_len == 0)
+                    ++first;
+            }
+        }
+        close(fd);
+        return offset;
+    }
+};
+
+#endif
@@ -4,20 +4,31 @@
 #include <string>
 #include <filesystem>
 
-using ParserFunc = size_t(*)(const char* line, void* out);
+using ParserFunc = size_t(*)(const char* line, void* out, char** text_out);
 
 ParserFunc Parser_mngr::create_parser(const std::string& format) {
-    // 1. Code generieren (Beispiel, passe an dein Format an)
+    // 0. Eingebauter Parser (static_parser.h) - kein Compiler, keine Startkosten
+    if (!force_jit) {
+        for (const builtin_parser& builtin : builtin_parsers()) {
+            if (builtin.format == format) {
+                printf("using builtin parser for %s\n", format.c_str());
+                parsers.push_back(builtin.parse);
+                return builtin.parse;
+            }
+        }
+    }
+
+    // 1. Code generieren (JIT-Fallback für Formate ohne eingebauten Parser)
 
     std::string name = "parser_" + std::to_string(parsers.size());
     
     std::string code = generate_code(name,format);
 
-    // 2. Kompilieren
-    compile_code(code, name);
+    // 2. Kompilieren (oder fertiges .so aus dem Cache)
+    std::string sofile = compile_code(code, name);
 
     // 3. Laden
-    void* fn_ptr = load_func(name, name); // "parse_line" ist der Name der generierten Funktion
+    void* fn_ptr = load_func(sofile, name); // die generierte Funktion heißt wie der Parser
     
     // 4. Cast und speichern
     ParserFunc fn = reinterpret_cast<ParserFunc>(fn_ptr);
@@ -26,10 +37,9 @@ ParserFunc Parser_mngr::create_parser(const std::string& format) {
     return fn;
 }
 
-void* Parser_mngr::load_func(const std::string& func_name, const std::string& symbol) 
+void* Parser_mngr::load_func(const std::string& sofile, const std::string& symbol) 
 {
     printf("loading function...\n");
-    std::string sofile = func_name + ".so";
     std::string abs_path = std::filesystem::absolute(sofile).string();
     
     printf("attempting to open file: %s\n",abs_path.c_str());
@@ -61,29 +71,52 @@ std::string Parser_mngr::generate_code(const std::string& func_name, const std::
     std::string template_code = read_file("parser_template.cpp");
 
     std::stringstream format_code;
+    format_dialect dialect = detect_dialect(format);
+    if (dialect == dialect_jsonl) {
+        // JSONL: Schema als Tabelle im Quelltext, ein Aufruf pro Datensatz
+        std::vector<jsonl_field> schema;
+        try {
+            schema.resize(parse_jsonl_format(format.data(), format.size(), nullptr));
+            parse_jsonl_format(format.data(), format.size(), schema.data());
+        } catch (const char* error) {
+            throw std::runtime_error(std::string(error) + ": " + format);
+        }
+        format_code << "    static const jsonl_field schema[] = {\n";
+        for (const jsonl_field& field : schema)
+            format_code << "        {\"" << std::string(field.key, field.length) << "\", " << field.length << ", '" << field.kind << "', " << field.slot << "},\n";
+        format_code << "    };\n";
+        format_code << "    p = parse_jsonl_record(p, fields, text, schema, " << schema.size() << ");\n";
+    }
+
+    // CSV und TSV: ein Aufruf pro Feld, bei TSV mit '\t' als Trennzeichen
+    std::string sep = dialect == dialect_tsv ? "<'\\t'>" : "";
     int arg_index = 0;
-    for (size_t i = 0; i < format.size(); ++i) {
+    for (size_t i = 0; i < format.size() && dialect != dialect_jsonl; ++i) {
         if (format[i] == '%') {
             ++i;
             if (i >= format.size()) break;
             switch (format[i]) {
                 case '_':
-                    format_code << "    parse_field_ignore(p, line);\n";
+                    format_code << "    parse_field_ignore" << sep << "(p, line);\n";
                     break;
                 case 's':
-                    format_code << "    parse_field_s(p, fields, " << arg_index << ", line);\n";
+                    format_code << "    parse_field_s" << sep << "(p, fields, " << arg_index << ", text);\n";
                     ++arg_index;
                     break;
                 case 'f':
-                    format_code << "    parse_field_f(p, fields, " << arg_index << ", line);\n";
+                    format_code << "    parse_field_f" << sep << "(p, fields, " << arg_index << ", line);\n";
                     ++arg_index;
                     break;
                 case 'V':
-                    format_code << "    parse_field_V(p, fields, " << arg_index << ", line);\n";
+                    format_code << "    parse_field_V" << sep << "(p, fields, " << arg_index << ", text);\n";
                     ++arg_index;
                     break;
                 case 'd':
-                    format_code << "    parse_field_d(p, fields, " << arg_index << ", line);\n";
+                    format_code << "    parse_field_d" << sep << "(p, fields, " << arg_index << ", line);\n";
+                    ++arg_index;
+                    break;
+                case '*':
+                    format_code << "    parse_field_skip" << sep << "(p, fields, " << arg_index << ", line);\n";
                     ++arg_index;
                     break;
                 default:
@@ -104,18 +137,7 @@ std::string Parser_mngr::generate_code(const std::string& func_name, const std::
 }
 
 
-void Parser_mngr::compile_code(const std::string& cpp_code, const std::string& name) 
+std::string Parser_mngr::compile_code(const std::string& cpp_code, const std::string& name) 
 {
-    std::string filename = name + ".cpp";
-    std::string sofile = name + ".so";
-
-    std::ofstream out(filename);
-    out << cpp_code;
-    out.close();
-
-    std::string cmd = "g++ -std=c++20 -g -O3 -fPIC -shared -nostdlib -nodefaultlibs " + filename + " -o " + sofile + " -lc";
-    if (system(cmd.c_str()) != 0) {
-        throw std::runtime_error("Compilerfehler bei: " + filename);
-    }
+    return jit_compile_cached(cpp_code, name);
 }
-
@@ -12,11 +12,20 @@
 #include <functional>
 #include <thread>
 #include <filesystem>
+#include <algorithm>
 
+#include "FileInput.h"
 #include "ThreadWorks.h"
 #include "Utillity.h"
+#include "static_parser.h"
+#include "jit_cache.h"
+#include "Column_set.h"
+#include "Dictionary_set.h"
 
-using ParserFunc = size_t (*)(const char *line, void *out);
+using ParserFunc = size_t (*)(const char *line, void *out, char **text_out);
+
+// Schreibposition im String-Arena-Bereich des aktuellen Parser-Threads (gesetzt vor jedem Block)
+inline thread_local char *parser_text_cursor = nullptr;
 
 class Parser_mngr
 {
@@ -32,57 +41,250 @@ public:
         }
         hSoFile.clear();
         parsers.clear();
+
+        for (char *arena : text_arenas)
+            delete[] arena;
+        text_arenas.clear();
     }
     
+    // Eingebauter Parser für bekannte Formate (static_parser.h), sonst JIT über parser_template.cpp
     ParserFunc create_parser(const std::string &format);
+
+    // true: immer per JIT erzeugen, auch wenn ein eingebauter Parser existiert (z.B. zum Vergleichen)
+    bool force_jit = false;
     //neu
+    // Das Format bestimmt auch den Dialekt der Eingabe (CSV, TSV, JSONL, siehe format_dialect in Utillity.h).
+    // JSONL hat keine Kopfzeile: dort start_line = header_lines(dialect_jsonl) = 0 übergeben.
     template <typename T>
     dataSet<T> *parse_multithreaded(const char *buffer, size_t buffer_size, size_t total_lines, const std::string &format, size_t num_threads = std::thread::hardware_concurrency(), size_t start_line = 1) // start_line ist 1 damit wir die Spaltenbeschriftungen überspringen können
+    {
+        size_t start_offset = skip_lines(buffer, buffer_size, start_line);
+        return parse_lines<T>(create_parser(format), buffer, buffer_size, start_offset, total_lines - start_line, format, num_threads, nullptr, 0);
+    }
+
+    // Wie oben, nutzt aber den Zeilenindex der Datei (wird bei Bedarf parallel aufgebaut):
+    // exakte Blockgrenzen und exakte Puffergrößen pro Thread
+    template <typename T>
+    dataSet<T> *parse_multithreaded(File &file, const std::string &format, size_t num_threads = std::thread::hardware_concurrency(), size_t start_line = 1)
+    {
+        return parse_file<T>(create_parser(format), file, format, num_threads, start_line);
+    }
+
+    // Mehrere Shards: der Parser wird einmal erzeugt, die Datensätze aller Shards werden zuerst gezählt
+    // (plan_file, Shards parallel), dann füllt jeder Shard mit einem Anteil der Threads seinen Ausschnitt
+    // eines gemeinsamen Zielpuffers in Shard-Reihenfolge. Es gibt keine Shard-Puffer und kein Zusammenkopieren.
+    // Jeder Shard hat eigene Kopfzeilen (start_line). Die ID-Bereiche der Shards werden im File_set abgelegt.
+    template <typename T>
+    dataSet<T> *parse_multithreaded(File_set &files, const std::string &format, size_t num_threads = std::thread::hardware_concurrency(), size_t start_line = 1)
     {
         ParserFunc parser = create_parser(format);
+        size_t shard_count = files.shard_count();
+        size_t workers = std::max<size_t>(1, std::min(num_threads, shard_count));
+        size_t threads_per_shard = std::max<size_t>(1, num_threads / workers);
 
-        std::function<int(const char *, void *)> parse_line = [parser](const char *line, void *out) { return parser(line, out); };
+        std::vector<line_fill_plan> plans(shard_count);
+        parallel_for_each_index(shard_count, workers, [&](size_t i) {
+            plans[i] = plan_file(files.shard(i), format, threads_per_shard, start_line);
+        });
+        std::vector<size_t> first(shard_count + 1, 0);
+        for (size_t i = 0; i < shard_count; ++i)
+            first[i + 1] = first[i] + plans[i].records();
 
-        printf("creating thread buffer for %zu threads...\n", num_threads);
+        T *data = new T[std::max<size_t>(1, first[shard_count])];
+        std::vector<T *> filled(shard_count);
+        std::vector<size_t> counts(shard_count);
+        parallel_for_each_index(shard_count, workers, [&](size_t i) {
+            filled[i] = fill_file<T>(parser, files.shard(i), plans[i], format, threads_per_shard, data + first[i], counts[i]);
+        });
 
-        // 1. Pro Thread eigenen Buffer + Counter anlegen
-        T** thread_buffer = new T*[num_threads];
-        size_t* thread_count = new size_t[num_threads];
+        std::vector<size_t> bases(shard_count + 1, 0);
+        bool overflow = false;
+        for (size_t i = 0; i < shard_count; ++i)
+        {
+            bases[i + 1] = bases[i] + counts[i];
+            overflow |= filled[i] != data + first[i];
+        }
+        files.set_record_bases(bases);
 
-        // 2. Startzeilen-Offset berechnen
-        size_t start_offset = 0;
-        size_t skipped = 0;
-        while (start_offset < buffer_size && skipped < start_line)
+        dataSet<T> *result = new dataSet<T>();
+        result->size = bases[shard_count];
+        if (!overflow)
         {
-            if (buffer[start_offset] == '\n')
-                ++skipped;
-            ++start_offset;
+            // Lücken hinter Shards mit weniger Datensätzen als gezählt schließen
+            for (size_t i = 0; i < shard_count; ++i)
+            {
+                if (bases[i] != first[i])
+                    memmove(data + bases[i], data + first[i], sizeof(T) * counts[i]);
+            }
+            result->data = data;
         }
+        else
+        {
+            printf("WARNING: mehr Datensätze als gezählt, Shards werden zusammenkopiert\n");
+            result->data = new T[std::max<size_t>(1, result->size)];
+            for (size_t i = 0; i < shard_count; ++i)
+            {
+                memcpy(result->data + bases[i], filled[i], sizeof(T) * counts[i]);
+                if (filled[i] != data + first[i])
+                    delete[] filled[i];
+            }
+            delete[] data;
+        }
+        printf("%zu Shards geparst: %zu Datensätze\n", shard_count, result->size);
+        return result;
+    }
+
+    // Spaltenweise Variante (Column_set.h): N ist die Zahl der belegten Felder des Formats (ohne %_).
+    // Blöcke wie bei threaded_line_fill (Datensätze über den Zeilenindex gezählt, Blöcke über einen atomaren
+    // Zähler verteilt). Der Parser schreibt jeden Datensatz in eine Zeile auf dem Stack, die sofort in die
+    // typisierten Spalten ab der Startposition des Blocks übertragen wird: es entsteht kein Zeilenpuffer.
+    // Liefert ein Block weniger Datensätze als gezählt (Leerzeilen), werden die Lücken danach geschlossen;
+    // liefert er mehr (überzählige Felder), kommen die übrigen in einen Überlauf und die Spalten werden neu
+    // zusammengesetzt.
+    template <unsigned int N>
+    Column_set *parse_columnar(File &file, const std::string &format, size_t num_threads = std::thread::hardware_concurrency(), size_t start_line = 1)
+    {
+        if (count_fields(format.c_str()) != (int)N)
+            throw std::runtime_error("parse_columnar: Format " + format + " hat nicht " + std::to_string(N) + " Felder");
+        ParserFunc parser = create_parser(format);
+        num_threads = std::max<size_t>(1, num_threads);
+        if (!file.has_line_index())
+            file.build_line_index(num_threads);
 
-        // 3. Threads starten und befüllen lassen
-        threaded_line_split<T>(buffer, format.c_str(), buffer_size, num_threads, start_offset, total_lines - start_line, parse_line, thread_buffer, thread_count);
+        using row_t = tuple_t<N, uintptr_t>;
+        size_t first_line = std::min(start_line, file.line_count());
+        size_t start_offset = file.line_index()[first_line];
+        size_t chunks = parse_chunk_count(file.size() - std::min(start_offset, file.size()), num_threads);
+        std::vector<size_t> bounds(chunks + 1), capacities(chunks), first(chunks + 1, 0), counts(chunks);
+        record_block_bounds(file.data(), file.size(), chunks, num_threads, start_offset, file.line_count() - first_line, file.line_index(), first_line, true, bounds.data(), capacities.data());
+        for (size_t c = 0; c < chunks; ++c)
+            first[c + 1] = first[c] + capacities[c];
 
-        // 4. Ergebnis zusammenführen
-        dataSet<T> *result = new dataSet<T>();
-        result->size = 0;
-        for (size_t t = 0; t < num_threads; ++t)
+        Column_set *result = new Column_set(format, first[chunks]);
+        std::vector<std::vector<row_t>> overflow(chunks);
+        size_t text_fields = string_fields(format.c_str()).size();
+        std::function<int(const char *, void *)> parse_line = [parser](const char *line, void *out) { return parser(line, out, &parser_text_cursor); };
+        parallel_for_each_index(chunks, num_threads, [&](size_t c) {
+            file.wait_range(bounds[c], bounds[c + 1]);
+            parser_text_cursor = allocate_text_arena(file.data(), bounds[c], bounds[c + 1], text_fields);
+            row_t row;
+            counts[c] = parse_records(file.data(), bounds[c], bounds[c + 1], parse_line, [&](size_t) -> void * { return &row; }, [&](size_t i) {
+                if (i < capacities[c])
+                    result->set_row(first[c] + i, (const uintptr_t *)&row);
+                else
+                    overflow[c].push_back(row);
+            });
+        });
+
+        bool overflowed = false;
+        for (size_t c = 0; c < chunks; ++c)
+            overflowed |= !overflow[c].empty();
+
+        size_t count = 0;
+        if (!overflowed)
         {
-            printf("thread %zu counted %zu lines\n",t,thread_count[t]);
-            result->size += thread_count[t];
+            // Lücken hinter zu kurzen Blöcken schließen (Reihenfolge bleibt erhalten)
+            for (size_t c = 0; c < chunks; ++c)
+            {
+                if (count != first[c])
+                    result->copy_rows(*result, first[c], count, counts[c]);
+                count += counts[c];
+            }
+            result->truncate(count);
+        }
+        else
+        {
+            printf("WARNING: mehr Datensätze als gezählt, Spalten werden neu zusammengesetzt\n");
+            for (size_t c = 0; c < chunks; ++c)
+                count += counts[c];
+            Column_set *merged = new Column_set(format, count);
+            for (size_t c = 0, offset = 0; c < chunks; ++c)
+            {
+                size_t in_place = std::min(counts[c], capacities[c]);
+                merged->copy_rows(*result, first[c], offset, in_place);
+                offset += in_place;
+                for (const row_t &row : overflow[c])
+                    merged->set_row(offset++, (const uintptr_t *)&row);
+            }
+            delete result;
+            result = merged;
         }
+        printf("%zu Datensätze in %zu Spalten geparst\n", result->size(), result->column_count());
+        return result;
+    }
 
-        printf("combining Buffer: Combined Buffer size %zu\n",result->size);
+    // Wörterbuchkodierung (Dictionary_set.h) der Textspalten eines geparsten dataSet: jede Textspalte mit
+    // höchstens size / Dictionary_set::min_repeat verschiedenen Werten bekommt eine Wertetabelle und Codes,
+    // die übrigen bleiben unkodiert. Die Spalten werden parallel geprüft, die Zeilen nicht verändert.
+    template <typename T>
+    Dictionary_set *dictionary_encode(const dataSet<T> *ds, const std::string &format, size_t num_threads = std::thread::hardware_concurrency())
+    {
+        size_t width = sizeof(T) / sizeof(uintptr_t);
+        if (count_fields(format.c_str()) != (int)width)
+            throw std::runtime_error("dictionary_encode: Format " + format + " hat nicht " + std::to_string(width) + " Felder");
 
-        result->data = new T[result->size];
-        for (size_t t = 0,offset = 0; t < num_threads; ++t)
+        Dictionary_set *result = new Dictionary_set(width, ds->size);
+        std::vector<int> slots = string_fields(format.c_str());
+        parallel_for_each_index(slots.size(), num_threads, [&](size_t i) {
+            result->encode((const uintptr_t *)ds->data, width, slots[i]);
+        });
+        for (int slot : slots)
         {
-            memcpy(result->data + offset, thread_buffer[t], sizeof(T) * thread_count[t]);
-            offset += thread_count[t];
-            delete[] thread_buffer[t];
+            if (const text_dictionary *dictionary = (*result)[slot])
+                printf("Spalte %d: %zu verschiedene Werte in %zu Datensätzen, kodiert\n", slot, dictionary->values.size(), ds->size);
         }
+        return result;
+    }
+
+    // Streaming-Variante: parst die Datei Block für Block (Fenstergröße des File_stream). Begrenzt ist nur der
+    // Lesepuffer: das Fenster wird für jeden Block wiederverwendet, statt die ganze Datei zu mappen. Die Datensätze
+    // aller Blöcke bleiben im Ergebnis, ihre String-Arenen (je Block so groß wie dessen Rohdaten) so lange wie der
+    // Parser_mngr; dieser Teil des Speicherbedarfs wächst also weiter mit der Eingabe.
+    template <typename T>
+    dataSet<T> *parse_streaming(File_stream &stream, const std::string &format, size_t num_threads = std::thread::hardware_concurrency(), size_t start_line = 1)
+    {
+        ParserFunc parser = create_parser(format);
+
+        dataSet<T> *result = new dataSet<T>();
+        result->size = 0;
+        result->data = nullptr;
+        size_t capacity = 0;
 
-        delete[] thread_buffer;
-        delete[] thread_count;
+        size_t block_size = 0;
+        size_t skipped = 0;
+        size_t block_number = 0;
+        while (char *block = stream.next_block(block_size))
+        {
+            // Kopfzeilen im ersten Block überspringen
+            size_t start_offset = 0;
+            while (start_offset < block_size && skipped < start_line)
+            {
+                if (block[start_offset] == '\n')
+                    ++skipped;
+                ++start_offset;
+            }
+
+            size_t block_lines = count_newlines(block + start_offset, block_size - start_offset) + 1;
+            dataSet<T> *parsed = parse_lines<T>(parser, block, block_size, start_offset, block_lines, format, num_threads, nullptr, 0);
+
+            if (result->size + parsed->size > capacity)
+            {
+                capacity = std::max(capacity * 2, result->size + parsed->size);
+                T *grown = new T[capacity];
+                if (result->data)
+                {
+                    memcpy(grown, result->data, sizeof(T) * result->size);
+                    delete[] result->data;
+                }
+                result->data = grown;
+            }
+            memcpy(result->data + result->size, parsed->data, sizeof(T) * parsed->size);
+            result->size += parsed->size;
+            delete[] parsed->data;
+            delete parsed;
+
+            printf("Block %zu von %s: %zu Bytes, bisher %zu Datensätze\n", block_number++, stream.path().c_str(), block_size, result->size);
+        }
         return result;
     }
 
@@ -91,10 +293,109 @@ private:
     std::vector<ParserFunc> parsers;
     int parser_index = 0;
 
+    // Normalisierte Texte aller geparsten Datensätze, ein zusammenhängender Bereich pro Thread und Block.
+    // Lebt so lange wie der Parser_mngr, die Eingabedatei kann nach dem Parsen geschlossen werden.
+    std::vector<char *> text_arenas;
+    std::mutex arena_mutex;
+
+    // Legt einen String-Arena-Bereich für den Block [begin, end) an: normalisierte Texte sind nie länger als
+    // die Eingabe, pro Textfeld kommen Längenpräfix und Terminator hinzu
+    char *allocate_text_arena(const char *buffer, size_t begin, size_t end, size_t text_fields)
+    {
+        if (text_fields == 0)
+            return nullptr;
+        size_t lines = count_newlines(buffer + begin, end - begin) + 1;
+        size_t bytes = (end - begin) + lines * text_fields * (text_prefix + 1) + 64;
+        char *arena = new char[bytes];
+        std::lock_guard<std::mutex> lock(arena_mutex);
+        text_arenas.push_back(arena);
+        return arena;
+    }
+
 private:
-    void *load_func(const std::string &func_name, const std::string &symbol);
+    // Offset hinter den ersten lines Zeilen (Kopfzeilen)
+    static size_t skip_lines(const char *buffer, size_t buffer_size, size_t lines)
+    {
+        size_t offset = 0;
+        size_t skipped = 0;
+        while (offset < buffer_size && skipped < lines)
+        {
+            if (buffer[offset] == '\n')
+                ++skipped;
+            ++offset;
+        }
+        return offset;
+    }
+
+    // Blockaufteilung einer Datei über ihren Zeilenindex (bei Bedarf parallel aufgebaut). Der Index beachtet
+    // Anführungszeichen wie CSV; JSONL-Zeilen dürfen unpaarige '"' enthalten (\"), dort werden die Blockgrenzen
+    // ohne Index gesucht.
+    line_fill_plan plan_file(File &file, const std::string &format, size_t num_threads, size_t start_line)
+    {
+        format_dialect dialect = detect_dialect(format);
+        if (dialect == dialect_jsonl)
+        {
+            file.wait_all();
+            return plan_line_fill(file.data(), file.size(), num_threads, skip_lines(file.data(), file.size(), start_line), file.line_count(), nullptr, 0, record_quote(dialect));
+        }
+
+        if (!file.has_line_index())
+            file.build_line_index(num_threads);
+
+        size_t first_line = std::min(start_line, file.line_count());
+        return plan_line_fill(file.data(), file.size(), num_threads, file.line_index()[first_line], file.line_count() - first_line, file.line_index(), first_line, record_quote(dialect));
+    }
+
+    // Parst die Datei nach plan in target (fill_line_plan), jeder Block bekommt einen eigenen String-Arena-Bereich
+    template <typename T>
+    T *fill_file(ParserFunc parser, File &file, const line_fill_plan &plan, const std::string &format, size_t num_threads, T *target, size_t &count)
+    {
+        std::function<int(const char *, void *)> parse_line = [parser](const char *line, void *out) { return parser(line, out, &parser_text_cursor); };
+
+        size_t text_fields = string_fields(format.c_str()).size();
+        std::function<void(size_t, size_t, size_t)> before_block = [&](size_t, size_t begin, size_t end) {
+            file.wait_range(begin, end);
+            parser_text_cursor = allocate_text_arena(file.data(), begin, end, text_fields);
+        };
+        return fill_line_plan<T>(plan, file.data(), num_threads, parse_line, target, count, before_block);
+    }
+
+    template <typename T>
+    dataSet<T> *parse_file(ParserFunc parser, File &file, const std::string &format, size_t num_threads, size_t start_line)
+    {
+        line_fill_plan plan = plan_file(file, format, num_threads, start_line);
+        T *target = new T[std::max<size_t>(1, plan.records())];
+        dataSet<T> *result = new dataSet<T>();
+        result->data = fill_file<T>(parser, file, plan, format, num_threads, target, result->size);
+        if (result->data != target)
+            delete[] target;
+        printf("%zu Datensätze geparst\n", result->size);
+        return result;
+    }
+
+    // Count-then-fill (threaded_line_fill): viele kleine Blöcke, Datensätze pro Block zählen, ein Zielpuffer,
+    // die Threads holen sich die Blöcke dynamisch und schreiben direkt in deren Ausschnitt.
+    // Kein Zusammenführen, kein zweiter Zeilenpuffer. Jeder Block bekommt einen eigenen String-Arena-Bereich.
+    template <typename T>
+    dataSet<T> *parse_lines(ParserFunc parser, const char *buffer, size_t buffer_size, size_t start_offset, size_t total_lines, const std::string &format, size_t num_threads, const size_t *line_offsets, size_t first_line)
+    {
+        std::function<int(const char *, void *)> parse_line = [parser](const char *line, void *out) { return parser(line, out, &parser_text_cursor); };
+
+        size_t text_fields = string_fields(format.c_str()).size();
+        std::function<void(size_t, size_t, size_t)> before_block = [&](size_t, size_t begin, size_t end) {
+            parser_text_cursor = allocate_text_arena(buffer, begin, end, text_fields);
+        };
+
+        dataSet<T> *result = new dataSet<T>();
+        result->data = threaded_line_fill<T>(buffer, buffer_size, num_threads, start_offset, total_lines, parse_line, result->size, line_offsets, first_line, before_block, record_quote(detect_dialect(format)));
+        printf("%zu Datensätze geparst\n", result->size);
+        return result;
+    }
+
+
+    void *load_func(const std::string &sofile, const std::string &symbol);
     std::string generate_code(const std::string &func_name, const std::string &format);
-    void compile_code(const std::string &cpp_code, const std::string &name);
+    std::string compile_code(const std::string &cpp_code, const std::string &name);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,135 @@
+#ifndef RESULT_FILE_H
+#define RESULT_FILE_H
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Binäres Ergebnisformat (Output_mngr::write_matches mit ".bin"). Die Datei ist so aufgebaut, dass sie
+// gemappt und ohne Parsen direkt benutzt werden kann (Result_file, Evaluation_mngr, externe Tools):
+//
+//   result_header                       64 Bytes, Offsets relativ zum Dateianfang
+//   match_record[match_count]           sortiert nach (id_a, id_b), id_a < id_b, jedes Paar genau einmal
+//   uint64_t[cluster_count + 1]         optional: Beginn jedes Clusters in cluster_members
+//   uint64_t[member_count]              optional: IDs der Cluster, je Cluster aufsteigend
+//
+// Alle Werte in Host-Byte-Reihenfolge (little endian auf x86_64/aarch64), alle Bereiche 8-Byte-ausgerichtet.
+// Neue Felder kommen ans Ende des Headers und erhöhen result_version; Leser lehnen unbekannte Versionen ab.
+
+static constexpr char result_magic[8] = {'D', 'U', 'P', 'R', 'E', 'S', 'L', 'T'};
+static constexpr uint32_t result_version = 1;
+
+enum result_flags : uint32_t {
+    result_has_clusters = 1u << 0
+};
+
+struct match_record {
+    uint64_t id_a;
+    uint64_t id_b;
+    double score;
+};
+
+struct result_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t match_count;
+    uint64_t matches_offset;
+    uint64_t cluster_count;
+    uint64_t cluster_offsets_offset;
+    uint64_t cluster_members_offset;
+    uint64_t member_count;
+};
+
+static_assert(sizeof(match_record) == 24, "match_record muss gepackt sein");
+static_assert(sizeof(result_header) == 64, "result_header muss 64 Bytes groß sein");
+
+// Nur lesend gemappte Ergebnisdatei
+class Result_file {
+public:
+    explicit Result_file(const std::string& path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            throw std::runtime_error("Konnte Ergebnisdatei nicht öffnen: " + path);
+        struct stat sb;
+        if (fstat(fd, &sb) == -1 || (size_t)sb.st_size < sizeof(result_header))
+        {
+            close(fd);
+            throw std::runtime_error("Ergebnisdatei zu klein: " + path);
+        }
+        mapping_size = sb.st_size;
+        mapping = (const char*)mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED)
+            throw std::runtime_error("Konnte Ergebnisdatei nicht mappen: " + path);
+
+        header = (const result_header*)mapping;
+        std::string error;
+        if (memcmp(header->magic, result_magic, sizeof(result_magic)) != 0)
+            error = "keine Ergebnisdatei";
+        else if (header->version != result_version)
+            error = "unbekannte Version " + std::to_string(header->version);
+        else if (!in_bounds(header->matches_offset, header->match_count, sizeof(match_record)))
+            error = "Matches außerhalb der Datei";
+        else if (has_clusters() && (!in_bounds(header->cluster_offsets_offset, header->cluster_count + 1, sizeof(uint64_t)) ||
+                                    !in_bounds(header->cluster_members_offset, header->member_count, sizeof(uint64_t))))
+            error = "Cluster außerhalb der Datei";
+        if (!error.empty())
+        {
+            munmap((void*)mapping, mapping_size);
+            throw std::runtime_error(path + ": " + error);
+        }
+        if (header->match_count)
+            madvise((void*)mapping, mapping_size, MADV_WILLNEED);
+    }
+
+    ~Result_file() { munmap((void*)mapping, mapping_size); }
+
+    Result_file(const Result_file&) = delete;
+    Result_file& operator=(const Result_file&) = delete;
+
+    size_t match_count() const { return header->match_count; }
+    const match_record* matches() const { return (const match_record*)(mapping + header->matches_offset); }
+
+    bool has_clusters() const { return header->flags & result_has_clusters; }
+    size_t cluster_count() const { return has_clusters() ? header->cluster_count : 0; }
+
+    // IDs des Clusters i (aufsteigend), size = Anzahl
+    const uint64_t* cluster(size_t i, size_t& size) const
+    {
+        const uint64_t* offsets = (const uint64_t*)(mapping + header->cluster_offsets_offset);
+        size = offsets[i + 1] - offsets[i];
+        return (const uint64_t*)(mapping + header->cluster_members_offset) + offsets[i];
+    }
+
+    // Binäre Suche nach dem Paar (Reihenfolge egal), nullptr wenn es kein Match ist
+    const match_record* find(uint64_t a, uint64_t b) const
+    {
+        if (a > b) std::swap(a, b);
+        const match_record* begin = matches();
+        const match_record* end = begin + match_count();
+        const match_record* it = std::lower_bound(begin, end, match_record{a, b, 0.0}, [](const match_record& l, const match_record& r) {
+            return l.id_a != r.id_a ? l.id_a < r.id_a : l.id_b < r.id_b;
+        });
+        return it != end && it->id_a == a && it->id_b == b ? it : nullptr;
+    }
+
+private:
+    bool in_bounds(uint64_t offset, uint64_t count, size_t element) const
+    {
+        return offset % 8 == 0 && offset <= mapping_size && count <= (mapping_size - offset) / element;
+    }
+
+    const char* mapping = nullptr;
+    size_t mapping_size = 0;
+    const result_header* header = nullptr;
+};
+
+#endif
@@ -3,6 +3,8 @@
 #include <cmath>
 #include <cstddef>
 #include <functional>
+#include <algorithm>
+#include <cstring>
 #include "FileInput.h"
 #include "DataTypes.h"
 #include "Utillity.h"
@@ -15,78 +17,186 @@
 
 
 
-template <typename T>
-inline void threaded_line_split(const char* file_content, const char* format,  size_t content_size, size_t num_threads, size_t start, size_t total_lines, std::function<int(const char*, void*)> parse_line, T** thread_buffers,size_t* thread_counts)
+// Parst alle Datensätze in [block_start, block_end) nacheinander: target(i) liefert den Speicher, in den der
+// Parser den i-ten Datensatz schreibt, commit(i) wird aufgerufen, sobald der Datensatz zum Block zählt.
+// Gibt die Anzahl der Datensätze zurück.
+// Der Parser verbraucht Leerzeilen hinter einem Datensatz mit; liegt eine Blockgrenze auf einer Leerzeile,
+// reicht der letzte Datensatz nur um Zeilenumbrüche über block_end hinaus und zählt noch zu diesem Block,
+// der folgende Block überspringt die Leerzeilen an seinem Anfang.
+template <typename Target, typename Commit>
+inline size_t parse_records(const char* file_content, size_t block_start, size_t block_end, const std::function<int(const char*, void*)>& parse_line, Target&& target, Commit&& commit)
 {
-
-    printf("Starte line_split...\n");
-
-    printf("Dateigröße: %zu, Start: %zu, Gesamtzeilen: %zu\n", content_size, start, total_lines);
-
-    if (num_threads <= 1)
+    size_t line_start = block_start;
+    while (line_start < block_end && (file_content[line_start] == '\n' || file_content[line_start] == '\r'))
+        ++line_start;
+    size_t out_idx = 0;
+    while (line_start < block_end)
     {
+        int read = parse_line(&file_content[line_start], target(out_idx));
+        if (read <= 0)
+        { 
+            break; 
+        }
+        if (line_start + read > block_end)
+        {
+            bool only_line_endings = true;
+            for (size_t i = block_end; i < line_start + read; ++i)
+                only_line_endings &= file_content[i] == '\n' || file_content[i] == '\r';
+            if (only_line_endings)
+                commit(out_idx++);
+            break;
+        }
 
-        printf("Nur ein Thread, starte Single-Thread-Verarbeitung...\n");
-
-        thread_buffers[0] = new T[total_lines]; // Reserve space for the first thread
+        line_start += read;
+        if (line_start < block_end && (file_content[line_start] == '\0' || file_content[line_start] == '\n' || file_content[line_start] == '\r')) // skip line endings
+        {    
+            ++line_start;
+        }
+        commit(out_idx++); //after each line processed go to next writing position
+    }
+    return out_idx;
+}
 
-        // Single-thread fallback
-        thread_counts[0] = 0;
-        size_t line_start = start;
-        while (line_start < content_size)
+// Parst alle Zeilen in [block_start, block_end) nach buffer; wächst der Puffer über capacity hinaus, wird er verdoppelt.
+// owns_buffer == false: buffer ist ein Ausschnitt eines fremden Puffers und wird beim Vergrößern nicht freigegeben
+// (buffer zeigt danach auf den neuen, eigenen Puffer).
+template <typename T>
+inline size_t parse_line_range(const char* file_content, size_t block_start, size_t block_end, const std::function<int(const char*, void*)>& parse_line, T*& buffer, size_t& capacity, bool owns_buffer = true)
+{
+    auto target = [&](size_t out_idx) -> void* {
+        if (out_idx == capacity) // Schätzung war zu klein -> Puffer vergrößern statt über das Ende zu schreiben
         {
-            T* out_ptr = thread_buffers[0] + thread_counts[0];
-            int read = parse_line(&file_content[line_start], static_cast<void*>(out_ptr));
+            size_t new_capacity = capacity * 2 + 2;
+            T* grown = new T[new_capacity];
+            memcpy(grown, buffer, sizeof(T) * out_idx);
+            if (owns_buffer)
+                delete[] buffer;
+            owns_buffer = true;
+            buffer = grown;
+            capacity = new_capacity;
+        }
+        return buffer + out_idx;
+    };
+    return parse_records(file_content, block_start, block_end, parse_line, target, [](size_t) {});
+}
+
+// Legt block_count Blöcke auf Datensatzanfänge: real_offsets[0..block_count] sind die Blockgrenzen,
+// capacities[b] die Zahl der Datensätze im Block b. num_threads: Threads für die parallelen Durchläufe.
+// Mit line_offsets (Zeilenindex der Datei, File::line_index(); first_line: erste zu parsende Zeile darin)
+// werden die Grenzen exakt auf Zeilenanfänge gelegt und die Datensätze aus dem Index abgezählt.
+// Ohne Index werden die Grenzen über die Parität der Anführungszeichen gesucht (s.u.); exact_counts zählt
+// dann die Datensätze jedes Blocks in einem zweiten parallelen Durchlauf, sonst werden sie geschätzt.
+// Exakt heißt hier: höchstens so viele, wie der Parser liefert (Leerzeilen zählen mit, der Parser überspringt sie).
+// record_quote: '"' bei CSV/TSV, '\0' bei JSONL (jedes '\n' beendet einen Datensatz, siehe record_quote in Utillity.h).
+inline void record_block_bounds(const char* file_content, size_t content_size, size_t block_count, size_t num_threads, size_t start, size_t total_lines, const size_t* line_offsets, size_t first_line, bool exact_counts, size_t* real_offsets, size_t* capacities, char record_quote = '"')
+{
+    // 1. Bereiche grob aufteilen
+    size_t per_block_bytes = (content_size - start) / block_count;
 
-            if (read <= 0 || (line_start + read) > content_size) break;
+    if (line_offsets)
+    {
+        // 2. Mit Zeilenindex: Byte-Ziel per Binärsuche auf den nächsten Zeilenanfang legen, Zeilenzahl ist die Indexdifferenz
+        printf("Zeilenanfänge aus Index übernehmen...\n");
+        const size_t* first = line_offsets + first_line;
+        const size_t* last = first + total_lines;
+        size_t* line_bounds = new size_t[block_count + 1];
+        line_bounds[0] = 0;
+        for (size_t b = 1; b < block_count; ++b)
+            line_bounds[b] = std::max(line_bounds[b - 1], (size_t)(std::lower_bound(first, last, start + b * per_block_bytes) - first));
+        line_bounds[block_count] = total_lines;
 
-            line_start += read;
-            if (line_start < content_size && (file_content[line_start] == '\0' || file_content[line_start] == '\n' || file_content[line_start] == '\r'))
-                ++line_start;
+        for (size_t b = 0; b <= block_count; ++b)
+            real_offsets[b] = line_bounds[b] < total_lines ? first[line_bounds[b]] : content_size;
+        real_offsets[0] = start;
 
-            ++thread_counts[0];
-            printf("Thread 0: Verarbeitet Zeichen %zu, Output-Index %zu\n", line_start, thread_counts[0]);
-        }
+        for (size_t b = 0; b < block_count; ++b)
+            capacities[b] = line_bounds[b + 1] - line_bounds[b];
+        delete[] line_bounds;
         return;
     }
 
-    printf("Anzahl Threads: %zu, Start: %zu, Gesamtzeilen: %zu\n", num_threads, start, total_lines);
+    // 2. An Datensatzanfänge anpassen. Ein '\n' innerhalb von Anführungszeichen (mehrzeiliger Titel)
+    //    ist keine Grenze: jeder Thread zählt parallel die '"' seines groben Bereichs, das Präfix-XOR
+    //    der Paritäten liefert den Zustand an jeder Grenze, ohne die Datei vorher seriell zu lesen.
+    printf("Anpassen der Datensatzanfänge...\n");
 
-    size_t* raw_offsets = new size_t[num_threads +1];
-    size_t* real_offsets = new size_t[num_threads + 1];
+    size_t* rough = new size_t[block_count + 1];
+    for (size_t b = 0; b < block_count; ++b)
+        rough[b] = start + b * per_block_bytes;
+    rough[block_count] = content_size;
 
-    // 1. Bereiche grob aufteilen
-    size_t per_thread_bytes = content_size / num_threads;
-    for (size_t t = 0; t < num_threads; ++t)
+    bool* odd_quotes = new bool[block_count];
+    parallel_for_each_index(block_count, num_threads, [&](size_t b) {
+        odd_quotes[b] = scan_quotes(file_content + rough[b], rough[b + 1] - rough[b], record_quote).odd_quotes;
+    });
+
+    real_offsets[0] = start;
+    bool quoted = false;
+    for (size_t b = 1; b < block_count; ++b)
+    {
+        quoted ^= odd_quotes[b - 1];
+        size_t pos = rough[b];
+        if (pos > start && file_content[pos - 1] == '\n' && !quoted)
+            real_offsets[b] = pos; // grobe Grenze liegt schon auf einem Datensatzanfang
+        else
+            real_offsets[b] = pos + next_record_start(file_content + pos, content_size - pos, quoted, record_quote);
+        real_offsets[b] = std::max(real_offsets[b], real_offsets[b - 1]);
+    }
+    real_offsets[block_count] = content_size; //dont allow reads over the end of the file
+    delete[] rough;
+    delete[] odd_quotes;
+
+    if (exact_counts)
     {
-        raw_offsets[t] = start + t * per_thread_bytes;
-        //printf("Thread %zu: [%zu ~ %zu]\n", t, raw_offsets[t],raw_offsets[t] + per_thread_bytes);
+        // Jeder Block beginnt außerhalb von Anführungszeichen: Datensätze = '\n' außerhalb + ein unterminierter Rest
+        parallel_for_each_index(block_count, num_threads, [&](size_t b) {
+            size_t begin = real_offsets[b], end = real_offsets[b + 1];
+            capacities[b] = scan_quotes(file_content + begin, end - begin, record_quote).record_ends + (end > begin && file_content[end - 1] != '\n');
+        });
+        return;
     }
 
-    // 2. An Zeilenanfänge anpassen
+    // Puffergröße schätzen, parse_line_range vergrößert bei Bedarf
+    size_t expected_lines = total_lines / block_count;
+    size_t buffered_lines = expected_lines + (size_t)((expected_lines / 10)+2); // bei kleinen Dateien fällt der Puffer konstant zu klein aus, daher +2
+    for (size_t b = 0; b < block_count; ++b)
+        capacities[b] = buffered_lines;
+}
+
+// Jeder Thread parst seinen Block (record_block_bounds) in einen eigenen Puffer (thread_buffers[t], thread_counts[t] Einträge).
+// before_block (optional): wird von jedem Thread vor dem Parsen mit Threadnummer und Bytebereich aufgerufen
+// (auf Daten warten bei read_uring, String-Arena des Threads anlegen).
+template <typename T>
+inline void threaded_line_split(const char* file_content, const char* format,  size_t content_size, size_t num_threads, size_t start, size_t total_lines, std::function<int(const char*, void*)> parse_line, T** thread_buffers,size_t* thread_counts, const size_t* line_offsets = nullptr, size_t first_line = 0, std::function<void(size_t, size_t, size_t)> before_block = nullptr)
+{
 
-    printf("Anpassen der Zeilenanfänge...\n");
+    printf("Starte line_split...\n");
 
-    real_offsets[0] = start;
-    for (size_t t = 0; t < num_threads; ++t)
+    printf("Dateigröße: %zu, Start: %zu, Gesamtzeilen: %zu\n", content_size, start, total_lines);
+
+    if (num_threads <= 1)
     {
-        size_t pos = raw_offsets[t];
-        if (pos == 0) pos = 1;
-        while (pos < content_size && file_content[pos - 1] != '\n')
-        {
-            ++pos;
-        }
-        real_offsets[t] = pos;
+
+        printf("Nur ein Thread, starte Single-Thread-Verarbeitung...\n");
+
+        size_t capacity = total_lines;
+        if (before_block) before_block(0, start, content_size);
+        thread_buffers[0] = new T[capacity]; // Reserve space for the first thread
+        thread_counts[0] = parse_line_range<T>(file_content, start, content_size, parse_line, thread_buffers[0], capacity);
+        printf("Thread 0: %zu Zeilen verarbeitet\n", thread_counts[0]);
+        return;
     }
-    real_offsets[num_threads] = content_size; //dont allow reads over the end of the file
-    delete[] raw_offsets; // no longer needed
 
-    // 3. Buffer reservieren (doppelte Größe)
-    size_t expected_lines = total_lines / num_threads;
-    size_t buffered_lines = expected_lines + (size_t)((expected_lines / 10)+2); // bei kleinen Dateien fällt der Puffer konstant zu klein aus, daher +2
+    printf("Anzahl Threads: %zu, Start: %zu, Gesamtzeilen: %zu\n", num_threads, start, total_lines);
+
+    size_t* real_offsets = new size_t[num_threads + 1];
+    size_t* capacities = new size_t[num_threads];
+    record_block_bounds(file_content, content_size, num_threads, num_threads, start, total_lines, line_offsets, first_line, false, real_offsets, capacities);
+
+    // 3. Buffer reservieren
     for (size_t t = 0; t < num_threads; ++t) {
-        printf("Thread %zu: Reserviere Puffer für %zu Zeilen\n", t, buffered_lines);
-        thread_buffers[t] = new T[buffered_lines]; //allocated buffer per thread
+        printf("Thread %zu: Reserviere Puffer für %zu Zeilen\n", t, capacities[t]);
+        thread_buffers[t] = new T[capacities[t]]; //allocated buffer per thread
         thread_counts[t] = 0;
         printf("Thread %zu: -> [%zu - %zu]\n", t, real_offsets[t], real_offsets[t+1]);
     }
@@ -97,34 +207,11 @@ inline void threaded_line_split(const char* file_content, const char* format,  s
     {
         size_t block_start = real_offsets[t];
         size_t block_end = real_offsets[t + 1];
-        size_t* count_ptr = &thread_counts[t];
-        T* buffer_ptr = thread_buffers[t];
-        size_t buffer_size = block_end - block_start;
-
 
-        threads[t] = std::thread([=, &parse_line]()
+        threads[t] = std::thread([=, &parse_line, &before_block]()
         {
-            size_t line_start = block_start;
-            size_t out_idx = 0;
-            while (line_start < block_end)
-            {
-                T* out_ptr = buffer_ptr + out_idx;
-                int read = parse_line(&file_content[line_start], static_cast<void*>(out_ptr));
-                if (read <= 0 || (line_start + read) > block_end)
-                { 
-                    break; 
-                }
-
-                line_start += read;
-                if (line_start < block_end && (file_content[line_start] == '\n' || file_content[line_start] == '\r')) // skip line endings
-                {    
-                    ++line_start;
-                }
-                ++out_idx; //after each line processed go to next writing position
-                //thread_counts[t]++;
-            }
-
-            thread_counts[t] = out_idx;
+            if (before_block) before_block(t, block_start, block_end);
+            thread_counts[t] = parse_line_range<T>(file_content, block_start, block_end, parse_line, thread_buffers[t], capacities[t]);
         });
     }
 
@@ -133,5 +220,113 @@ inline void threaded_line_split(const char* file_content, const char* format,  s
         threads[t].join();
 
     delete[] real_offsets;
+    delete[] capacities;
     delete[] threads;
-}
\ No newline at end of file
+}
+
+// Blockgröße für threaded_line_fill: viele kleine Blöcke statt eines Blocks pro Thread, damit ein Block mit
+// langen oder teuren Zeilen nicht alle anderen Threads am Ende warten lässt.
+// parse_min_chunk_bytes ist veränderbar, damit Tests auch mit kleinen Dateien mehrere Blöcke pro Thread erzeugen.
+static const size_t parse_chunks_per_thread = 16;
+inline size_t parse_min_chunk_bytes = 256 * 1024;
+
+inline size_t parse_chunk_count(size_t bytes, size_t num_threads)
+{
+    return std::clamp(bytes / parse_min_chunk_bytes, num_threads, num_threads * parse_chunks_per_thread);
+}
+
+// Blockaufteilung für den Count-then-fill (threaded_line_fill): viele kleine Blöcke auf Datensatzanfängen
+// (parse_chunk_count), deren Datensätze vorab gezählt werden (Zeilenindex oder paralleler Zähldurchlauf).
+// Block c hat im Zielpuffer den festen Ausschnitt ab first[c], in Dateireihenfolge.
+struct line_fill_plan {
+    std::vector<size_t> offsets;    // Blockgrenzen, chunks() + 1 Einträge
+    std::vector<size_t> capacities; // gezählte Datensätze je Block
+    std::vector<size_t> first;      // Startposition je Block im Zielpuffer, chunks() + 1 Einträge
+
+    size_t chunks() const { return capacities.size(); }
+    size_t records() const { return first.back(); }
+};
+
+// record_quote wie bei record_block_bounds.
+inline line_fill_plan plan_line_fill(const char* file_content, size_t content_size, size_t num_threads, size_t start, size_t total_lines, const size_t* line_offsets = nullptr, size_t first_line = 0, char record_quote = '"')
+{
+    num_threads = std::max<size_t>(1, num_threads);
+    size_t chunks = parse_chunk_count(content_size - std::min(start, content_size), num_threads);
+    printf("Starte line_fill: Dateigröße: %zu, Start: %zu, Threads: %zu, Blöcke: %zu\n", content_size, start, num_threads, chunks);
+
+    line_fill_plan plan;
+    plan.offsets.resize(chunks + 1);
+    plan.capacities.resize(chunks);
+    record_block_bounds(file_content, content_size, chunks, num_threads, start, total_lines, line_offsets, first_line, true, plan.offsets.data(), plan.capacities.data(), record_quote);
+
+    plan.first.assign(chunks + 1, 0);
+    for (size_t c = 0; c < chunks; ++c)
+        plan.first[c + 1] = plan.first[c] + plan.capacities[c];
+    printf("%zu Datensätze gezählt, ein Zielpuffer für alle Blöcke\n", plan.records());
+    return plan;
+}
+
+// Parst die Blöcke von plan nach target (plan.records() Plätze, darf Ausschnitt eines größeren Puffers sein).
+// Die Threads holen sich die Blöcke über einen atomaren Zähler (parallel_for_each_index), wer früher fertig
+// ist, übernimmt mehr Blöcke. Liefert der Parser weniger Datensätze als gezählt (Leerzeilen), werden die
+// Lücken danach zusammengeschoben und target zurückgegeben; liefert er mehr (Zeilen mit überzähligen Feldern),
+// parst der Block in einen eigenen Puffer weiter und die Blöcke werden in einen neuen Puffer zusammenkopiert,
+// der statt target zurückgegeben wird. count: Zahl der Datensätze im Ergebnis.
+// before_block wird pro Block (Blocknummer statt Threadnummer) aufgerufen.
+template <typename T>
+inline T* fill_line_plan(const line_fill_plan& plan, const char* file_content, size_t num_threads, const std::function<int(const char*, void*)>& parse_line, T* target, size_t& count, const std::function<void(size_t, size_t, size_t)>& before_block = nullptr)
+{
+    size_t chunks = plan.chunks();
+    std::vector<T*> buffers(chunks);
+    std::vector<size_t> capacities(plan.capacities);
+    std::vector<size_t> counts(chunks);
+    parallel_for_each_index(chunks, std::max<size_t>(1, num_threads), [&](size_t c) {
+        if (before_block) before_block(c, plan.offsets[c], plan.offsets[c + 1]);
+        buffers[c] = target + plan.first[c];
+        counts[c] = parse_line_range<T>(file_content, plan.offsets[c], plan.offsets[c + 1], parse_line, buffers[c], capacities[c], false);
+    });
+
+    bool overflow = false;
+    for (size_t c = 0; c < chunks; ++c)
+        overflow |= buffers[c] != target + plan.first[c];
+
+    count = 0;
+    if (!overflow)
+    {
+        // Lücken hinter zu kurzen Blöcken schließen (Reihenfolge bleibt erhalten)
+        for (size_t c = 0; c < chunks; ++c)
+        {
+            if (count != plan.first[c])
+                memmove(target + count, target + plan.first[c], sizeof(T) * counts[c]);
+            count += counts[c];
+        }
+        return target;
+    }
+
+    printf("WARNING: mehr Datensätze als gezählt, Blöcke werden zusammenkopiert\n");
+    for (size_t c = 0; c < chunks; ++c)
+        count += counts[c];
+    T* merged = new T[std::max<size_t>(1, count)];
+    for (size_t c = 0, offset = 0; c < chunks; ++c)
+    {
+        memcpy(merged + offset, buffers[c], sizeof(T) * counts[c]);
+        offset += counts[c];
+        if (buffers[c] != target + plan.first[c])
+            delete[] buffers[c];
+    }
+    return merged;
+}
+
+// Count-then-fill: wie threaded_line_split, aber ohne Thread-Puffer und ohne Zusammenführen. Es gibt eine
+// einzige Allokation für alle Datensätze (plan_line_fill, fill_line_plan); nur bei mehr Datensätzen als
+// gezählt wird wie früher zusammenkopiert. count: Zahl der Datensätze im Ergebnis.
+template <typename T>
+inline T* threaded_line_fill(const char* file_content, size_t content_size, size_t num_threads, size_t start, size_t total_lines, std::function<int(const char*, void*)> parse_line, size_t& count, const size_t* line_offsets = nullptr, size_t first_line = 0, std::function<void(size_t, size_t, size_t)> before_block = nullptr, char record_quote = '"')
+{
+    line_fill_plan plan = plan_line_fill(file_content, content_size, num_threads, start, total_lines, line_offsets, first_line, record_quote);
+    T* result = new T[std::max<size_t>(1, plan.records())];
+    T* filled = fill_line_plan<T>(plan, file_content, num_threads, parse_line, result, count, before_block);
+    if (filled != result)
+        delete[] result;
+    return filled;
+}
@@ -7,10 +7,13 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <dlfcn.h>
 
 #include "FileInput.h"
 #include "DataTypes.h"
 #include "Utillity.h"
+#include "Dictionary_set.h"
+#include "jit_cache.h"
 
 
 #ifndef TOKENIZATION_MNGR_H
@@ -51,70 +54,50 @@ public:
             delete child[i];
     }
 
+    // Liest eine Tokenliste: eine Bedeutung pro Zeile, gleichbedeutende Schreibweisen durch ';' getrennt.
+    // Jeder Token wird im Puffer mit simd_normalize_utf8 normalisiert (dieselbe Abbildung wie beim Parsen der
+    // Datensätze, auch für Umlaute), ein abschließendes '\r' (CRLF) gehört nicht zum Token.
     size_t fimport_token(const char *filename)
     {
-        void* jumpTable[128] = {
-            &&eof, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 0–7
-            &&loop, &&loop, &&spaceFound, &&loop, &&loop, &&loop, &&loop, &&loop,     // 8–15
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 16–23
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 24–31
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 32–39
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 40–47
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 48–55
-            &&loop, &&loop, &&loop, &&semFound, &&loop, &&loop, &&loop, &&loop, // 56–63
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 64–71
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 72–79
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 80–87
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 88–95
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 96–103
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 104–111
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 112–119
-            &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop, &&loop,     // 120–127
-        };
-
-        File file(filename,true);
+        File_config config;
+        config.writable = true; // die Tokenliste wird direkt im Puffer normalisiert
+        File file(filename, true, false, config);
 
         char* p = file.data();
-        char* tokenbegin = p;
+        char* end = p + file.size();
         size_t lineIndex = 1; //start at 1 for our id_index in the nodes is 0 if not a final node
-        
-        loop: //rewrite numeric characters to match map indentation
-        *p = lut[*p]; //rework token
-        goto *jumpTable[*(++p)]; //goto the scenario, chosen by that character found
-
-        semFound: //found a semicolon, inserting from last token
-        *p = 0; //mark end of string
-        insert(tokenbegin,lineIndex,(p-tokenbegin)); //insert, until current position, at current index, no incement, since we stay at this line
-        ++p; //move read to next possible character
-        tokenbegin = p;
-        goto *jumpTable[*(p)]; //jump to whatever we find, should be the first char of the next token
-
-        spaceFound:
-        *p = 0;             // mark end of string
-        insert(tokenbegin, lineIndex++,(p - tokenbegin)-1); // insert, until current position
-        ++p;                // move read to next possible character
-        tokenbegin = p;
-        goto *jumpTable[*(p)]; // jump to whatever we find, should be the first char of the next token
-
-        eof:
-        *p = 0;                                          // mark end of string
-        insert(tokenbegin, lineIndex++, (p - tokenbegin)); // insert, until current position
-        return lineIndex; // return the number of tokens with different meaning
+
+        while (p < end && *p)
+        {
+            char* tokenbegin = p;
+            while (p < end && *p && *p != ';' && *p != '\n')
+                ++p;
+            size_t len = p - tokenbegin;
+            if (len > 0 && tokenbegin[len - 1] == '\r')
+                --len;
+            len = simd_normalize_utf8(tokenbegin, tokenbegin, len);
+            if (len > 0)
+                insert(tokenbegin, lineIndex, len); // ';' bleibt auf demselben Index
+            if (p < end && *p == '\n')
+                ++lineIndex;
+            if (p < end && *p)
+                ++p;
+        }
+        return lineIndex + 1; // Zeilenzahl + 1 wie bisher (Indizes beginnen bei 1)
     }
 
-    token get_possible_index(char *p) const
+    // Längstes bekanntes Präfix ab p, höchstens bis end (Textende, siehe text_view)
+    token get_possible_index(const char *p, const char *end) const
     {
-        void* jumpTable[ALPHABET_SIZE] = {};
-
         const token_node *node = this;
-        char *current = p;
+        const char *current = p;
 
-        while (*current)
+        while (current < end)
         {
             unsigned char c = *current;
             //if (c < ALPHABET_ANCHOR) //sollte nicht passieren können
                 //return 0; // Optional: Zeichen außerhalb des gültigen Bereichs
-            if(c < ALPHABET_ANCHOR || c > 127){*current = whitespace;c = *current;}
+            if(c < ALPHABET_ANCHOR || c > 127){c = whitespace;}
             //printf("jumping to childnode: %c\n",c);
             node = node->child[c - ALPHABET_ANCHOR];
             
@@ -280,14 +263,24 @@ public:
     }
 
     // Prüfen, ob ein Token enthalten ist
-    token contains(char* token,token_class tk) const
+    token contains(const char* token, const char* end, token_class tk) const
     {
-        return classes[tk].get_possible_index(token);
+        return classes[tk].get_possible_index(token, end);
     }
 
-    dataSet<out_buf_t>* tokenize_multithreaded(dataSet<in_buf_t>* ds,const char* format,size_t num_threads)
+    // Slots, die der Tokenizer (filter_tokens) und generate_set der Ausgabetypen lesen: nur die Texte.
+    // Für Parser_mngr über project_format: alle anderen Spalten werden beim Parsen nur übersprungen.
+    std::vector<int> consumed_slots(const char* format) const
+    {
+        return string_fields(format);
+    }
+
+    // dictionaries (optional, Parser_mngr::dictionary_encode): kodierte Textspalten werden pro Wert einmal
+    // zerlegt, die Datensätze übernehmen das Ergebnis über ihren Code (filter_field)
+    dataSet<out_buf_t>* tokenize_multithreaded(dataSet<in_buf_t>* ds,const char* format,size_t num_threads, const Dictionary_set* dictionaries = nullptr)
     {
         TokenizerFunc tokenizer = this->create_tokenizer(format);
+        prepare_dictionaries(ds, dictionaries);
 
         std::function<int(in_buf_t*, out_buf_t*, Tokenization_mngr*)> tokenize_field = [tokenizer](in_buf_t* line, out_buf_t*out, Tokenization_mngr* tkm) { return tokenizer(line, out, tkm); };
 
@@ -316,6 +309,9 @@ public:
             delete[] thread_buffer[t];
         }
         delete[] thread_buffer;
+        m_value_tokens.clear();
+        m_dictionaries.clear();
+        m_rows = nullptr;
         return ret;
     }
 
@@ -325,11 +321,11 @@ public:
 
         std::string code = generate_code(name,format);
 
-        // 2. Kompilieren
-        compile_code(code, name);
+        // 2. Kompilieren (oder fertiges .so aus dem Cache)
+        std::string sofile = compile_code(code, name);
 
         // 3. Laden
-        void* fn_ptr = load_func(name, name); // "tokenize_line" ist der Name der generierten Funktion
+        void* fn_ptr = load_func(sofile, name); // die generierte Funktion heißt wie der Tokenizer
         
         // 4. Cast und speichern
         TokenizerFunc fn = reinterpret_cast<TokenizerFunc>(fn_ptr);
@@ -337,26 +333,50 @@ public:
         return fn;
     }
 
-    void filter_tokens(char *text, out_buf_t *buffer)
+    // Textfeld slot eines Datensatzes zerlegen (vom generierten Tokenizer aufgerufen). Bei kodierten Spalten
+    // wird das Ergebnis des Werts übernommen: pro Kategorie der zuletzt gefundene Token, token_count zählt
+    // wie in filter_tokens nur Kategorien, die vorher leer waren.
+    void filter_field(const in_buf_t *line, size_t slot, out_buf_t *out)
     {
-        char *p = text;
+        if (slot < m_value_tokens.size() && m_dictionaries[slot])
+        {
+            const out_buf_t &value = m_value_tokens[slot][m_dictionaries[slot]->codes[line - m_rows]];
+            for (size_t i = 0; i < N; ++i)
+            {
+                token index = ((const token *)&value)[i];
+                if (index == 0)
+                    continue;
+                token &current = ((token *)out)[i];
+                if (current == 0)
+                    out->token_count++;
+                current = index;
+            }
+            return;
+        }
+        filter_tokens(field_text(line->data[slot]), out);
+    }
+
+    void filter_tokens(text_view text, out_buf_t *buffer)
+    {
+        const char *p = text.data;
+        const char *end = text.end();
 
-        while (*p)
+        while (p < end)
         {
             // Überspringe Whitespaces
-            while (*p && *p==whitespace)
+            while (p < end && (unsigned char)*p == whitespace)
             {
                 ++p;
             }
 
-            if (!*p)
+            if (p == end)
                 break; // EOL erreicht
 
             // Token-Suche starten
             bool matched = false;
-            for (int i = 0; i < N; ++i)
+            for (size_t i = 0; i < N; ++i)
             {
-                token index = contains(p, static_cast<category>(i));
+                token index = contains(p, end, static_cast<category>(i));
                 if (index > 0)
                 {
                     m_num_class_tokens_found[i]++; // 
@@ -371,7 +391,7 @@ public:
                     }
 
                     // p um die Länge des gefundenen Tokens weiterschieben
-                    while (*p && *p!=whitespace)
+                    while (p < end && (unsigned char)*p != whitespace)
                         ++p;
                     matched = true;
                     break;
@@ -381,7 +401,7 @@ public:
             if (!matched)
             {
                 // Kein Token erkannt → weiter zum nächsten Wort
-                while (*p && *p != whitespace)
+                while (p < end && (unsigned char)*p != whitespace)
                     ++p;
             }
         }
@@ -509,6 +529,37 @@ public:
     }
 
 private:
+    // Zerlegt jeden Wert der kodierten Spalten einmal. Die Trefferzählung (m_num_class_tokens_found) wird
+    // mit der Zahl der Datensätze des Werts hochgerechnet, damit sie der zeilenweisen Zerlegung entspricht.
+    void prepare_dictionaries(const dataSet<in_buf_t> *ds, const Dictionary_set *dictionaries)
+    {
+        m_rows = ds->data;
+        m_dictionaries.clear();
+        m_value_tokens.clear();
+        if (!dictionaries || dictionaries->size() != ds->size)
+            return;
+
+        m_dictionaries.resize(dictionaries->slot_count(), nullptr);
+        m_value_tokens.resize(dictionaries->slot_count());
+        for (size_t slot = 0; slot < dictionaries->slot_count(); ++slot)
+        {
+            const text_dictionary *dictionary = (*dictionaries)[slot];
+            if (!dictionary)
+                continue;
+            m_dictionaries[slot] = dictionary;
+            m_value_tokens[slot].resize(dictionary->values.size());
+            for (size_t code = 0; code < dictionary->values.size(); ++code)
+            {
+                size_t found_before[N];
+                memcpy(found_before, m_num_class_tokens_found, sizeof(found_before));
+                const char *text = dictionary->values[code];
+                filter_tokens({text, text_length(text)}, &m_value_tokens[slot][code]);
+                for (size_t i = 0; i < N; ++i)
+                    m_num_class_tokens_found[i] += (m_num_class_tokens_found[i] - found_before[i]) * (dictionary->occurrences[code] - 1);
+            }
+        }
+    }
+
     inline void threaded_tokenization(in_buf_t *buffer, size_t buffer_size, std::function<int(in_buf_t*, out_buf_t*,Tokenization_mngr* tkm)> tokenize_entry, size_t num_threads, out_buf_t** thread_buffers)
     {
         // Korrekte Blockaufteilung wie beim Zusammenfügen
@@ -550,10 +601,9 @@ private:
         delete[] threads;
     }
 
-    void *load_func(const std::string &func_name, const std::string &symbol)
+    void *load_func(const std::string &sofile, const std::string &symbol)
     {
         printf("loading function...\n");
-        std::string sofile = func_name + ".so";
         std::string abs_path = std::filesystem::absolute(sofile).string();
         
         printf("attempting to open file: %s\n",abs_path.c_str());
@@ -596,17 +646,18 @@ private:
                     case '_':
                         break;
                     case 's':
-                        format_code << "\ttkm->filter_tokens((char*)(line->data["<<arg_index<<"]), out);\n";
+                        format_code << "\ttkm->filter_field(line, " << arg_index << ", out);\n";
                         ++arg_index;
                         break;
                     case 'f':
                         ++arg_index;
                         break;
                     case 'V':
-                        format_code << "\ttkm->filter_tokens((char*)(line->data[" << arg_index << "]), out);\n";
+                        format_code << "\ttkm->filter_field(line, " << arg_index << ", out);\n";
                         ++arg_index;
                         break;
                     case 'd':
+                    case '*':
                         ++arg_index;
                         break;
                     default:
@@ -631,26 +682,17 @@ private:
         return template_code;
     }
     
-    void compile_code(const std::string &cpp_code, const std::string &name)
+    std::string compile_code(const std::string &cpp_code, const std::string &name)
     {
-        std::string filename = name + ".cpp";
-        std::string sofile = name + ".so";
-
-        printf("creating tokenizer %s\n",filename.c_str());
-
-        std::ofstream out(filename);
-        out << cpp_code;
-        out.close();
-
-        std::string cmd = "g++ -std=c++20 -g -O3 -fPIC -shared -nostdlib -nodefaultlibs " + filename + " -o " + sofile + " -lc";
-        if (system(cmd.c_str()) != 0)
-        {
-            throw std::runtime_error("Compilerfehler bei: " + filename);
-        }
+        printf("creating tokenizer %s\n", name.c_str());
+        return jit_compile_cached(cpp_code, name);
     }
 
     int numClasses = N; 
     token_node classes[N]; 
+    const in_buf_t* m_rows = nullptr;                     // Datensätze der laufenden Zerlegung (Index für die Codes)
+    std::vector<const text_dictionary*> m_dictionaries;   // je Slot, nullptr: Feld wird pro Datensatz zerlegt
+    std::vector<std::vector<out_buf_t>> m_value_tokens;   // je Slot und Code: Tokens des Werts
     size_t  m_tokenizer_mngr_id = 0;
     std::vector<void *> hSoFile;
     std::vector<TokenizerFunc> tokenizers;
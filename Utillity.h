@@ -6,8 +6,12 @@
 #include <typeinfo>
 #include <fstream>
 #include <sstream>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
 #include "constants.h"
 #include "DataTypes.h"
+#include "simd_utils.h"
 
 #ifndef UTILLITY_DUPLICATE_DETECTION_H
 #define UTILLITY_DUPLICATE_DETECTION_H
@@ -41,6 +45,10 @@ inline void print_tuple(const uintptr_t* data, const char* format) {
                     ++field;
                     break;
                 }
+                case '*':
+                    printf("<übersprungen>");
+                    ++field;
+                    break;
                 case '_':
                     // skip field, do not print, do NOT increment field!
                     break;
@@ -105,23 +113,22 @@ inline char* find_and_clean_csv(char* p) {
         char* dst = p;  // Start writing at beginning of field
         ++p;  // Skip leading quote
         
-        // Process the quoted content
-        while (*p) {
-            if (*p == '"') {
-                if (*(p + 1) == '"') {
-                    // Properly handle escaped quotes ("") by converting to Escape character
-                    *dst++ = Escape;
-                    p += 2;  // Skip both quote characters
-                } else {
-                    // End of quoted field
-                    *dst = '\0';  // Properly null-terminate the output string
-                    ++p;  // Move past the closing quote
-                    break;
-                }
+        // Process the quoted content: Bytes bis zum nächsten '"' wie in copy_clean_csv normalisieren
+        while (true) {
+            char* quote = (char*)simd_find_quote(p);
+            dst += simd_normalize_utf8(p, dst, quote - p);
+            p = quote;
+            if (*p == '\0')
+                break;
+            if (*(p + 1) == '"') {
+                // Properly handle escaped quotes ("") by converting to Escape character
+                *dst++ = Escape;
+                p += 2;  // Skip both quote characters
             } else {
-                // Process normal character using the lookup table
-                *dst++ = lut[(unsigned char)*p];
-                ++p;
+                // End of quoted field
+                *dst = '\0';  // Properly null-terminate the output string
+                ++p;  // Move past the closing quote
+                break;
             }
         }
         
@@ -135,12 +142,10 @@ inline char* find_and_clean_csv(char* p) {
         // Unquoted field
         char* dst = p;
         
-        // Process all characters until delimiter
-        while (*p && *p != ',' && *p != '\n' && *p != '\r') {
-            // In-place transformation using lookup table
-            *dst++ = lut[(unsigned char)*p];
-            ++p;
-        }
+        // In-place transformation (simd_normalize_utf8, ASCII wie lut) bis zum Trennzeichen
+        char* end = (char*)simd_find_delimiter(p);
+        dst += simd_normalize_utf8(p, dst, end - p);
+        p = end;
         
         // Ensure proper null-termination if content was modified
         if (dst < p) {
@@ -151,6 +156,47 @@ inline char* find_and_clean_csv(char* p) {
     }
 }
 
+// Wie find_and_clean_csv, lässt die Eingabe aber unverändert: das normalisierte Feld wird nach text geschrieben
+// (Längenpräfix, Bytes, '\0', siehe text_view in DataTypes.h), text zeigt danach hinter das Feld.
+// Der Text des Feldes beginnt bei text + text_prefix (Wert von text vor dem Aufruf).
+// Gibt das Feldende (Sep, '\n', '\r' oder '\0') in der Eingabe zurück. Sep: ',' bei CSV, '\t' bei TSV.
+template <char Sep = ','>
+inline const char* copy_clean_csv(const char* p, char*& text)
+{
+    char* dst = text + text_prefix;
+
+    // Feldgrenzen und Anführungszeichen kommen aus den 64-Byte-Masken (simd_utils.h), die Bytes
+    // dazwischen normalisiert simd_normalize_utf8 (ASCII wie lut, 16/32 Bytes pro Schritt; Umlaute transliteriert)
+    if (*p == '"') {
+        ++p;  // Skip leading quote
+        while (true) {
+            const char* quote = simd_find_quote(p);
+            dst += simd_normalize_utf8(p, dst, quote - p);
+            p = quote;
+            if (*p == '\0')
+                break;
+            if (*(p + 1) == '"') {
+                *dst++ = Escape; // escaped quote ("")
+                p += 2;
+            } else {
+                ++p;  // Move past the closing quote
+                break;
+            }
+        }
+        p = simd_find_delimiter<Sep>(p);
+    } else {
+        const char* end = simd_find_delimiter<Sep>(p);
+        dst += simd_normalize_utf8(p, dst, end - p);
+        p = end;
+    }
+
+    uint32_t length = dst - (text + text_prefix);
+    memcpy(text, &length, sizeof(length));
+    *dst++ = '\0';
+    text = dst;
+    return p;
+}
+
 inline void replace_all(std::string &target, const std::string &placeholder, const std::string &value)
 {
     size_t pos;
@@ -172,6 +218,7 @@ inline int count_fields(const char* format) {
                 case 'f':
                 case 'd':
                 case 'V':
+                case '*':
                     ++count;
                     break;
                 default:
@@ -182,6 +229,127 @@ inline int count_fields(const char* format) {
     return count;
 }
 
+// Liefert die Feldindizes (ohne %_) aller String-Felder (%s, %V) im Formatstring
+inline std::vector<int> string_fields(const char* format) {
+    std::vector<int> slots;
+    int field = 0;
+    for (size_t i = 0; format[i]; ++i) {
+        if (format[i] == '%') {
+            ++i;
+            if (!format[i]) break;
+            switch (format[i]) {
+                case 's':
+                case 'V':
+                    slots.push_back(field);
+                    ++field;
+                    break;
+                case 'f':
+                case 'd':
+                case '*':
+                    ++field;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    return slots;
+}
+
+// Projektion: ersetzt alle belegenden Felder, deren Slot nicht in consumed_slots steht, durch %*.
+// Die Slots bleiben gleich (der Verbraucher liest data[slot] wie vorher), der Parser überspringt die
+// übrigen Spalten aber nur noch, statt sie zu normalisieren und abzulegen.
+inline std::string project_format(const std::string& format, const std::vector<int>& consumed_slots) {
+    std::string projected = format;
+    int slot = 0;
+    for (size_t i = 0; i + 1 < projected.size(); ++i) {
+        if (projected[i] != '%')
+            continue;
+        char& kind = projected[++i];
+        if (kind == '_')
+            continue;
+        if (std::find(consumed_slots.begin(), consumed_slots.end(), slot) == consumed_slots.end())
+            kind = '*';
+        ++slot;
+    }
+    return projected;
+}
+
+// Eingabedialekte des Format-Literals. Feldtypen und Slots sind in allen gleich (count_fields, string_fields,
+// project_format arbeiten unverändert), nur die Schreibweise der Eingabe unterscheidet sich:
+//   CSV    "%_,%s,%f"                        Felder durch ',' getrennt, "..." mit "" für ein Anführungszeichen
+//   TSV    "%_\t%s\t%f"                      wie CSV mit Tabulator als Trennzeichen (Dialekt excel-tab)
+//   JSONL  {"id":%_,"name":%s,"price":%f}    ein Objekt pro Zeile, Felder über ihren Namen in beliebiger
+//                                            Reihenfolge, unbekannte Namen werden übersprungen, fehlende leer bzw. 0
+enum format_dialect { dialect_csv, dialect_tsv, dialect_jsonl };
+
+inline format_dialect detect_dialect(const std::string& format)
+{
+    if (!format.empty() && format[0] == '{')
+        return dialect_jsonl;
+    return format.find('\t') != std::string::npos ? dialect_tsv : dialect_csv;
+}
+
+// Zeichen, innerhalb dessen ein '\n' keinen Datensatz beendet (scan_quotes, record_block_bounds).
+// JSON schreibt Zeilenumbrüche in Strings als \n: bei JSONL beendet jedes '\n' einen Datensatz.
+inline char record_quote(format_dialect dialect)
+{
+    return dialect == dialect_jsonl ? '\0' : '"';
+}
+
+// Kopfzeilen vor dem ersten Datensatz (start_line der Parser_mngr-Funktionen)
+inline size_t header_lines(format_dialect dialect)
+{
+    return dialect == dialect_jsonl ? 0 : 1;
+}
+
+// Dialekt einer Eingabedatei nach ihrer Endung (.jsonl/.ndjson, .tsv/.tab, sonst CSV), .gz/.zst zählen nicht
+inline format_dialect input_dialect(std::string path)
+{
+    auto strip = [&path](const std::string& suffix) {
+        bool match = path.size() > suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+        if (match)
+            path.resize(path.size() - suffix.size());
+        return match;
+    };
+    strip(".gz") || strip(".zst");
+    if (strip(".jsonl") || strip(".ndjson"))
+        return dialect_jsonl;
+    if (strip(".tsv") || strip(".tab"))
+        return dialect_tsv;
+    return dialect_csv;
+}
+
+// Überträgt ein CSV-Format in einen Dialekt: TSV ersetzt die Trennzeichen, JSONL stellt jedem Feld (auch %_)
+// seinen Namen aus keys voran. Der Tokenizer liest das Ergebnis mit dem CSV-Format wie bisher.
+inline std::string dialect_format(const std::string& csv_format, format_dialect dialect, const std::vector<std::string>& keys)
+{
+    if (dialect == dialect_csv)
+        return csv_format;
+    if (dialect == dialect_tsv)
+    {
+        std::string format = csv_format;
+        std::replace(format.begin(), format.end(), ',', '\t');
+        return format;
+    }
+
+    std::string format = "{";
+    size_t field = 0;
+    for (size_t i = 0; i + 1 < csv_format.size(); ++i)
+    {
+        if (csv_format[i] != '%')
+            continue;
+        if (field == keys.size())
+            throw std::runtime_error("dialect_format: zu wenige Feldnamen für " + csv_format);
+        if (field > 0)
+            format += ',';
+        format += '"' + keys[field++] + "\":%" + csv_format[++i];
+    }
+    if (field != keys.size())
+        throw std::runtime_error("dialect_format: zu viele Feldnamen für " + csv_format);
+    return format + "}";
+}
+
 // Prüft, ob Structgröße zur Feldanzahl passt
 template<typename T>
 inline void check_struct_size(const char* format) {
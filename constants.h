@@ -33,6 +33,26 @@ static const unsigned char lut[256] =
         whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace,
         whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace, whitespace,
         whitespace};
+
+// Transliteration für UTF-8-Zeichen U+00C0..U+017F (Latin-1 und Latin Extended-A), Index = Codepoint - 0xC0.
+// Ergebnis ist schon normalisiert (Kleinbuchstaben wie lut), höchstens 2 Zeichen und nie länger als die
+// 2-Byte-Sequenz. "" (×, ÷) und alle anderen Nicht-ASCII-Zeichen (Symbole wie ®, –) werden zu whitespace.
+static const unsigned translit_first = 0xC0;
+static const unsigned translit_last = 0x17F;
+static const char translit[translit_last - translit_first + 1][3] = {
+    "a", "a", "a", "a", "ae", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i", // U+00C0
+    "d", "n", "o", "o", "o", "o", "oe", "", "o", "u", "u", "u", "ue", "y", "th", "ss", // U+00D0
+    "a", "a", "a", "a", "ae", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i", // U+00E0
+    "d", "n", "o", "o", "o", "o", "oe", "", "o", "u", "u", "u", "ue", "y", "th", "y", // U+00F0
+    "a", "a", "a", "a", "a", "a", "c", "c", "c", "c", "c", "c", "c", "c", "d", "d", // U+0100
+    "d", "d", "e", "e", "e", "e", "e", "e", "e", "e", "e", "e", "g", "g", "g", "g", // U+0110
+    "g", "g", "g", "g", "h", "h", "h", "h", "i", "i", "i", "i", "i", "i", "i", "i", // U+0120
+    "i", "i", "ij", "ij", "j", "j", "k", "k", "k", "l", "l", "l", "l", "l", "l", "l", // U+0130
+    "l", "l", "l", "n", "n", "n", "n", "n", "n", "n", "n", "n", "o", "o", "o", "o", // U+0140
+    "o", "o", "oe", "oe", "r", "r", "r", "r", "r", "r", "s", "s", "s", "s", "s", "s", // U+0150
+    "s", "s", "t", "t", "t", "t", "t", "t", "u", "u", "u", "u", "u", "u", "u", "u", // U+0160
+    "u", "u", "u", "u", "w", "w", "y", "y", "y", "z", "z", "z", "z", "z", "z", "s", // U+0170
+};
 #endif
 
 // copilot generated comment:
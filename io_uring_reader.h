@@ -0,0 +1,211 @@
+#ifndef IO_URING_READER_H
+#define IO_URING_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#endif
+
+// Liest eine Datei mit io_uring in einen Speicherbereich, statt sie zu mappen. Es sind immer bis zu
+// queue_depth Lesezugriffe von je block_size Bytes gleichzeitig unterwegs, damit langsame (Netzwerk-)
+// Volumes nicht auf einzelne Page Faults der Parser-Threads warten. Benutzt direkt die Syscalls
+// (keine liburing-Abhängigkeit). Ist io_uring nicht verfügbar (alter Kernel, seccomp), wird mit pread gelesen.
+class Uring_reader {
+public:
+    explicit Uring_reader(unsigned queue_depth)
+    {
+#ifdef __linux__
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        ring_fd = (int)syscall(__NR_io_uring_setup, std::max(queue_depth, 1u), &params);
+        if (ring_fd < 0) return;
+
+        size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap)
+            sq_size = cq_size = std::max(sq_size, cq_size);
+
+        sq_ring_size = sq_size;
+        cq_ring_size = single_mmap ? 0 : cq_size;
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        sq_ring = mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+        cq_ring = single_mmap ? sq_ring : mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+        sqes = (io_uring_sqe*)mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+        if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED || sqes == MAP_FAILED)
+        {
+            release();
+            return;
+        }
+
+        char* sq = (char*)sq_ring;
+        char* cq = (char*)cq_ring;
+        sq_tail = (unsigned*)(sq + params.sq_off.tail);
+        sq_mask = *(unsigned*)(sq + params.sq_off.ring_mask);
+        sq_array = (unsigned*)(sq + params.sq_off.array);
+        cq_head = (unsigned*)(cq + params.cq_off.head);
+        cq_tail = (unsigned*)(cq + params.cq_off.tail);
+        cq_mask = *(unsigned*)(cq + params.cq_off.ring_mask);
+        cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+        depth = params.sq_entries;
+#endif
+    }
+
+    ~Uring_reader() { release(); }
+
+    Uring_reader(const Uring_reader&) = delete;
+    Uring_reader& operator=(const Uring_reader&) = delete;
+
+    bool available() const { return ring_fd >= 0; }
+    unsigned queue_depth() const { return depth; }
+
+    // Liest [0, size) aus fd nach dst, block_done(begin, end) wird für jeden fertigen Block aufgerufen
+    // (in beliebiger Reihenfolge). block_size muss zwischen 1 Byte und 1 GiB liegen. Der letzte Block wird zuerst angefordert, weil Indexprüfung und
+    // letzte Zeile ihn sofort brauchen, danach die übrigen von vorne.
+    void read_file(int fd, char* dst, size_t size, size_t block_size, const std::function<void(size_t, size_t)>& block_done)
+    {
+        if (!available())
+        {
+            read_with_pread(fd, dst, size, block_size, block_done);
+            return;
+        }
+#ifdef __linux__
+        size_t block_count = (size + block_size - 1) / block_size;
+        std::vector<size_t> block_read(block_count, 0); // gelesene Bytes pro Block
+        size_t next_block = 0;
+        size_t finished = 0;
+        unsigned in_flight = 0;
+        unsigned unsubmitted = 0; // eingetragen, aber vom Kernel noch nicht übernommen
+
+        while (finished < block_count)
+        {
+            // Warteschlange auffüllen
+            while (in_flight < depth && next_block < block_count)
+            {
+                size_t block = next_block == 0 ? block_count - 1 : next_block - 1;
+                queue_read(fd, dst, size, block_size, block, 0);
+                ++next_block;
+                ++in_flight;
+                ++unsubmitted;
+            }
+
+            int ret = (int)syscall(__NR_io_uring_enter, ring_fd, unsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                throw std::runtime_error(std::string("io_uring_enter: ") + strerror(errno));
+            if (ret > 0)
+                unsubmitted -= std::min<unsigned>(ret, unsubmitted);
+
+            // fertige Lesezugriffe einsammeln
+            unsigned head = *cq_head;
+            unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head)
+            {
+                const io_uring_cqe& cqe = cqes[head & cq_mask];
+                size_t block = cqe.user_data;
+                size_t block_len = std::min(block_size, size - block * block_size);
+                if (cqe.res < 0)
+                    throw std::runtime_error(std::string("io_uring read: ") + strerror(-cqe.res));
+                if (cqe.res == 0)
+                    throw std::runtime_error("io_uring read: unerwartetes Dateiende");
+
+                block_read[block] += cqe.res;
+                if (block_read[block] < block_len)
+                {
+                    queue_read(fd, dst, size, block_size, block, block_read[block]); // kurzer Read: Rest nachfordern
+                    ++unsubmitted;
+                }
+                else
+                {
+                    --in_flight;
+                    ++finished;
+                    block_done(block * block_size, block * block_size + block_len);
+                }
+            }
+            __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+        }
+#endif
+    }
+
+private:
+#ifdef __linux__
+    void queue_read(int fd, char* dst, size_t size, size_t block_size, size_t block, size_t done)
+    {
+        size_t offset = block * block_size + done;
+        size_t len = std::min(block_size, size - block * block_size) - done;
+
+        unsigned tail = *sq_tail;
+        unsigned index = tail & sq_mask;
+        io_uring_sqe& sqe = sqes[index];
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = fd;
+        sqe.addr = (uint64_t)(uintptr_t)(dst + offset);
+        sqe.len = (uint32_t)len;
+        sqe.off = offset;
+        sqe.user_data = block;
+        sq_array[index] = index;
+        __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+    }
+#endif
+
+    static void read_with_pread(int fd, char* dst, size_t size, size_t block_size, const std::function<void(size_t, size_t)>& block_done)
+    {
+        for (size_t begin = 0; begin < size; begin += block_size)
+        {
+            size_t end = std::min(size, begin + block_size);
+            for (size_t pos = begin; pos < end;)
+            {
+                ssize_t n = pread(fd, dst + pos, end - pos, pos);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) throw std::runtime_error(std::string("pread: ") + (n < 0 ? strerror(errno) : "unerwartetes Dateiende"));
+                pos += n;
+            }
+            block_done(begin, end);
+        }
+    }
+
+    void release()
+    {
+#ifdef __linux__
+        if (sqes && sqes != MAP_FAILED) munmap(sqes, sqes_size);
+        if (cq_ring && cq_ring != MAP_FAILED && cq_ring_size) munmap(cq_ring, cq_ring_size);
+        if (sq_ring && sq_ring != MAP_FAILED) munmap(sq_ring, sq_ring_size);
+        sqes = nullptr;
+        cq_ring = sq_ring = nullptr;
+#endif
+        if (ring_fd >= 0) close(ring_fd);
+        ring_fd = -1;
+    }
+
+    int ring_fd = -1;
+    unsigned depth = 0;
+#ifdef __linux__
+    void* sq_ring = nullptr;
+    void* cq_ring = nullptr;
+    size_t sq_ring_size = 0;
+    size_t cq_ring_size = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqes_size = 0;
+    unsigned* sq_tail = nullptr;
+    unsigned sq_mask = 0;
+    unsigned* sq_array = nullptr;
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned cq_mask = 0;
+    io_uring_cqe* cqes = nullptr;
+#endif
+};
+
+#endif
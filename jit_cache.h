@@ -0,0 +1,140 @@
+#ifndef JIT_CACHE_H
+#define JIT_CACHE_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <stdexcept>
+#include <filesystem>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <unistd.h>
+
+// Cache für die per JIT erzeugten Parser/Tokenizer (Parser_mngr, Tokenization_mngr). Das .so wird unter
+// dem Hash aus generiertem Quelltext (Template + Format), allen lokal eingebundenen Headern, Compilerversion
+// und Flags abgelegt und bei weiteren Läufen direkt mit dlopen geladen, ohne g++ aufzurufen.
+//
+// Verzeichnis: $DUPDETEC_JIT_CACHE, sonst $XDG_CACHE_HOME/dupdetec-jit, sonst ~/.cache/dupdetec-jit.
+// Mehrere Prozesse dürfen gleichzeitig übersetzen: jeder schreibt in eigene temporäre Dateinamen
+// (PID + Zähler) und benennt das fertige .so atomar um, es gibt keine gemeinsamen parser_N.cpp mehr.
+
+static constexpr const char* jit_compile_flags = "-std=c++20 -g -O3 -fPIC -shared -nostdlib -nodefaultlibs";
+
+inline uint64_t jit_hash(uint64_t hash, const std::string& text)
+{
+    for (unsigned char c : text)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull; // FNV-1a
+    }
+    return hash;
+}
+
+inline std::string jit_cache_dir()
+{
+    std::string dir;
+    if (const char* env = getenv("DUPDETEC_JIT_CACHE"))
+        dir = env;
+    else if (const char* xdg = getenv("XDG_CACHE_HOME"))
+        dir = std::string(xdg) + "/dupdetec-jit";
+    else if (const char* home = getenv("HOME"))
+        dir = std::string(home) + "/.cache/dupdetec-jit";
+    else
+        dir = "jit_cache";
+    std::filesystem::create_directories(dir);
+    return std::filesystem::absolute(dir).string();
+}
+
+// Ausgabe von "g++ --version" (einmal pro Prozess)
+inline const std::string& jit_compiler_version()
+{
+    static const std::string version = []() {
+        std::string result;
+        if (FILE* pipe = popen("g++ --version 2>&1", "r"))
+        {
+            char line[256];
+            while (fgets(line, sizeof(line), pipe))
+                result += line;
+            pclose(pipe);
+        }
+        return result;
+    }();
+    return version;
+}
+
+// Hängt den Inhalt aller mit #include "..." eingebundenen Header (rekursiv, relativ zu include_dir) an
+inline void jit_collect_headers(const std::string& code, const std::string& include_dir, std::set<std::string>& seen, std::string& out)
+{
+    std::istringstream lines(code);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        size_t pos = line.find("#include \"");
+        if (pos == std::string::npos)
+            continue;
+        size_t begin = pos + 10;
+        size_t end = line.find('"', begin);
+        if (end == std::string::npos)
+            continue;
+        std::string header = include_dir + "/" + line.substr(begin, end - begin);
+        if (!seen.insert(header).second)
+            continue;
+        std::ifstream in(header);
+        std::stringstream content;
+        content << in.rdbuf();
+        out += header + "\n" + content.str();
+        jit_collect_headers(content.str(), include_dir, seen, out);
+    }
+}
+
+// Liefert den Pfad eines .so für code; übersetzt nur, wenn es noch nicht im Cache liegt.
+// Lokale Header werden im aktuellen Verzeichnis gesucht (wie beim Übersetzen neben den Quellen).
+inline std::string jit_compile_cached(const std::string& code, const std::string& name)
+{
+    std::string include_dir = std::filesystem::current_path().string();
+    std::string headers;
+    std::set<std::string> seen;
+    jit_collect_headers(code, include_dir, seen, headers);
+
+    uint64_t hash = 14695981039346656037ull;
+    hash = jit_hash(hash, code);
+    hash = jit_hash(hash, headers);
+    hash = jit_hash(hash, jit_compiler_version());
+    hash = jit_hash(hash, jit_compile_flags);
+
+    char key[17];
+    snprintf(key, sizeof(key), "%016llx", (unsigned long long)hash);
+    std::string dir = jit_cache_dir();
+    std::string sofile = dir + "/" + name + "_" + key + ".so";
+    if (std::filesystem::exists(sofile))
+    {
+        printf("using cached %s\n", sofile.c_str());
+        return sofile;
+    }
+
+    static std::atomic<unsigned> counter{0};
+    std::string tmp = dir + "/" + name + "_" + key + "." + std::to_string(getpid()) + "." + std::to_string(counter++);
+    std::string filename = tmp + ".cpp";
+    std::ofstream out(filename);
+    out << code;
+    out.close();
+
+    printf("compiling %s\n", sofile.c_str());
+    std::string cmd = std::string("g++ ") + jit_compile_flags + " -I\"" + include_dir + "\" \"" + filename + "\" -o \"" + tmp + ".so\" -lc";
+    int status = system(cmd.c_str());
+    std::remove(filename.c_str());
+    if (status != 0)
+    {
+        std::remove((tmp + ".so").c_str());
+        throw std::runtime_error("Compilerfehler bei: " + name);
+    }
+    // atomar: parallele Prozesse sehen entweder kein oder ein vollständiges .so
+    std::filesystem::rename(tmp + ".so", sofile);
+    return sofile;
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include <string.h>
 #include <thread>
 #include <chrono>  // Für bessere Zeitmessung
+#include <filesystem>
 
 // Uncomment one of these to enable different debug levels
 // Limit_DEBUG_OUTPUT ist in debug_utils.h definiert
@@ -16,6 +17,7 @@
 #include "Tokenization_mngr.h"
 #include "Parser_mngr.h"
 #include "FileInput.h"
+#include "Output_mngr.h"
 #include "DataTypes.h"
 
 //Jaccard-Schwellwerte
@@ -42,6 +44,64 @@ std::string files[] =
 
 int main(int argc, char** argv)
 {   
+    // --stream <MiB>: Z1/Z2 blockweise mit festem Fenster lesen statt komplett zu mappen
+    size_t stream_window_mb = 0;
+    File_config input_config;
+    // --out1 <pfad> / --out2 <pfad>: Matches der Laptops/Storage schreiben ("lid,rid,score", ".bin" = binär)
+    // --clusters: binäre Ausgaben enthalten zusätzlich die Cluster-Tabellen
+    // --jit: Parser zur Laufzeit mit g++ erzeugen statt die eingebauten (static_parser.h) zu benutzen
+    std::string output_paths[2];
+    bool write_clusters = false;
+    bool force_jit = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--clusters") == 0)
+            write_clusters = true;
+        else if (strcmp(argv[i], "--jit") == 0)
+            force_jit = true;
+    }
+    // --z1 <pfad> / --z2 <pfad>: andere Eingabe für Laptops/Storage, "-" oder eine FIFO wird immer gestreamt,
+    // Glob-Muster oder Listen ("shards/laptops_*.csv", "a.csv,b.csv") werden als File_set parallel gelesen
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (strcmp(argv[i], "--stream") == 0)
+            stream_window_mb = strtoul(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--z1") == 0)
+            files[0] = argv[i + 1];
+        else if (strcmp(argv[i], "--z2") == 0)
+            files[1] = argv[i + 1];
+        else if (strcmp(argv[i], "--out1") == 0)
+            output_paths[0] = argv[i + 1];
+        else if (strcmp(argv[i], "--out2") == 0)
+            output_paths[1] = argv[i + 1];
+        else if (strcmp(argv[i], "--prefault") == 0)
+        {
+            // --prefault <none|populate|willneed|parallel|thp>[:threads]: Seiten von Z1/Z2 vorab laden
+            const char* names[] = {"none", "populate", "willneed", "parallel", "thp"};
+            for (int p = 0; p < 5; ++p)
+                if (strncmp(argv[i + 1], names[p], strlen(names[p])) == 0)
+                    input_config.prefault = (prefault_policy)p;
+            if (const char* threads = strchr(argv[i + 1], ':'))
+                input_config.prefault_threads = strtoul(threads + 1, nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--uring") == 0)
+        {
+            // --uring <queue_depth>: Z1/Z2 mit io_uring statt mmap einlesen
+            input_config.backend = read_uring;
+            input_config.queue_depth = strtoul(argv[i + 1], nullptr, 10);
+        }
+    }
+    auto is_set = [&](const std::string& path) {
+        return File_set::is_pattern(path) && !std::filesystem::exists(path);
+    };
+    auto must_stream = [&](const std::string& path) {
+        return !is_set(path) && (stream_window_mb > 0 || path == "-" || !std::filesystem::is_regular_file(path));
+    };
+    auto must_map = [&](const std::string& path) {
+        return !is_set(path) && !must_stream(path);
+    };
+    size_t stream_window = stream_window_mb ? stream_window_mb << 20 : File_stream::default_window;
+
     // Print debug configuration information
     printf("Reading Dataset: Laptops from path: %s\n",files[0].c_str());
     printf("Reading Dataset: Storage from path: %s\n",files[1].c_str());
@@ -59,15 +119,25 @@ int main(int argc, char** argv)
     maxThreads = maxThreads > 0 ? maxThreads : 1; //in case thread count failed set it to one thread
 
     Parser_mngr parser_mngr;
+    parser_mngr.force_jit = force_jit;
 
     // Zeitmessung mit std::chrono für bessere Genauigkeit
     auto start_total = std::chrono::high_resolution_clock::now();
 
-    // 1. Datei-Objekte erzeugen
-    File file1(files[0]);
-    File file2(files[1]);
-    File file3(files[2],true);
-    File file4(files[3],true);
+    // Z1/Z2 dürfen auch als JSONL (.jsonl/.ndjson) oder TSV (.tsv/.tab) vorliegen (input_dialect), ohne vorherige
+    // Umwandlung nach CSV. JSONL hat keine Kopfzeile und braucht keinen Zeilenindex (jede Zeile ein Datensatz).
+    const format_dialect dialect1 = input_dialect(files[0]);
+    const format_dialect dialect2 = input_dialect(files[1]);
+
+    // 1. Datei-Objekte erzeugen (Zeilenindex wird neben den Dateien als .lidx abgelegt und bei weiteren Läufen wiederverwendet)
+    File* file1 = must_map(files[0]) ? new File(files[0], dialect1 == dialect_jsonl, dialect1 != dialect_jsonl, input_config) : nullptr;
+    File* file2 = must_map(files[1]) ? new File(files[1], dialect2 == dialect_jsonl, dialect2 != dialect_jsonl, input_config) : nullptr;
+    File_stream* stream1 = must_stream(files[0]) ? new File_stream(files[0], stream_window, record_quote(dialect1)) : nullptr;
+    File_stream* stream2 = must_stream(files[1]) ? new File_stream(files[1], stream_window, record_quote(dialect2)) : nullptr;
+    File_set* set1 = is_set(files[0]) ? new File_set(files[0], true, input_config) : nullptr;
+    File_set* set2 = is_set(files[1]) ? new File_set(files[1], true, input_config) : nullptr;
+    File file3(files[2], false, true);
+    File file4(files[3], false, true);
 
     //assembler_brand: 0
     //assembler_modell: 1
@@ -143,23 +213,46 @@ int main(int argc, char** argv)
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    // 2. Multi-Threaded Parsing für alle Datasets
-    dataSet<single_t>* dataSet1 = parser_mngr.parse_multithreaded<single_t>(file1.data(), file1.size(), file1.line_count(), "%_,%V", maxThreads);
+    // 2. Multi-Threaded Parsing für alle Datasets. Geparst werden nur die Spalten, die der Tokenizer liest
+    //    (project_format), die übrigen belegen ihren Slot, werden aber nur übersprungen (z.B. der Preis).
+    //    Bei TSV/JSONL dasselbe Format im Dialekt der Eingabe, JSONL-Felder mit den Namen der CSV-Kopfzeilen.
+    const std::string format1 = project_format(dialect_format("%_,%V", dialect1, {"id", "title"}), m_Laptop_tokenization_mngr->consumed_slots("%_,%V"));
+    const std::string format2 = project_format(dialect_format("%_,%s,%f,%s,%s,%V", dialect2, {"id", "name", "price", "brand", "description", "category"}),
+                                               m_Storage_tokenization_mngr->consumed_slots("%_,%s,%f,%s,%s,%V"));
+    dataSet<single_t>* dataSet1 = stream1 ? parser_mngr.parse_streaming<single_t>(*stream1, format1, maxThreads, header_lines(dialect1))
+                                : set1    ? parser_mngr.parse_multithreaded<single_t>(*set1, format1, maxThreads, header_lines(dialect1))
+                                          : parser_mngr.parse_multithreaded<single_t>(*file1, format1, maxThreads, header_lines(dialect1));
     printf("Parsed %zu lines from file1:\n", dataSet1->size);
     //print_Dataset(*dataSet1, "%_,%V");
 
-    dataSet<quintupel>* dataSet2 = parser_mngr.parse_multithreaded<quintupel>(file2.data(), file2.size(), file2.line_count(), "%_,%s,%f,%s,%s,%V", maxThreads);
+    dataSet<quintupel>* dataSet2 = stream2 ? parser_mngr.parse_streaming<quintupel>(*stream2, format2, maxThreads, header_lines(dialect2))
+                                 : set2    ? parser_mngr.parse_multithreaded<quintupel>(*set2, format2, maxThreads, header_lines(dialect2))
+                                           : parser_mngr.parse_multithreaded<quintupel>(*file2, format2, maxThreads, header_lines(dialect2));
     printf("Parsed %zu lines from file2\n", dataSet2->size);
     //print_Dataset(*dataSet2, "%_,%s,%f,%s,%s,%V");
 
-    dataSet<match>* dataSetSol1 = parser_mngr.parse_multithreaded<match>(file3.data(), file3.size(), file3.line_count(), "%d,%d", maxThreads);
-    printf("Parsed %zu lines from file3\n", dataSetSol1->size);
+    // Textspalten mit wenigen verschiedenen Werten (Marke, Kategorie) wörterbuchkodieren: der Tokenizer
+    // zerlegt dann jeden Wert nur einmal
+    Dictionary_set* dictionaries1 = parser_mngr.dictionary_encode(dataSet1, format1, maxThreads);
+    Dictionary_set* dictionaries2 = parser_mngr.dictionary_encode(dataSet2, format2, maxThreads);
+
+    // Lösungen spaltenweise: die Auswertung liest nur die beiden ID-Spalten
+    Column_set* dataSetSol1 = parser_mngr.parse_columnar<2>(file3, "%d,%d", maxThreads);
+    printf("Parsed %zu lines from file3\n", dataSetSol1->size());
     //print_Dataset(*dataSetSol1, "%d,%d");
 
-    dataSet<match>* dataSetSol2 = parser_mngr.parse_multithreaded<match>(file4.data(), file4.size(), file4.line_count(), "%d,%d", maxThreads);
-    printf("Parsed %zu lines from file4\n", dataSetSol2->size);
+    Column_set* dataSetSol2 = parser_mngr.parse_columnar<2>(file4, "%d,%d", maxThreads);
+    printf("Parsed %zu lines from file4\n", dataSetSol2->size());
     //print_Dataset(*dataSetSol2, "%d,%d");
 
+    // Eingabedateien schließen: die Texte der Datensätze liegen in den String-Arenen des Parser_mngr
+    delete file1;
+    delete file2;
+    delete stream1;
+    delete stream2;
+    delete set1;
+    delete set2;
+
     auto elapsedParse = std::chrono::high_resolution_clock::now() - start;
     printf("time elapsed for reading Files: %.2f s\n", 
            std::chrono::duration<double>(elapsedParse).count());
@@ -167,8 +260,8 @@ int main(int argc, char** argv)
     start = std::chrono::high_resolution_clock::now();
     printf("tokenizing Data...\n");
 
-    dataSet<laptop> *tokenized_laptops = m_Laptop_tokenization_mngr->tokenize_multithreaded(dataSet1, "%_,%V", maxThreads);
-    dataSet<storage_drive> *tokenized_storage = m_Storage_tokenization_mngr->tokenize_multithreaded(dataSet2, "%_,%s,%f,%s,%s,%V", maxThreads);
+    dataSet<laptop> *tokenized_laptops = m_Laptop_tokenization_mngr->tokenize_multithreaded(dataSet1, "%_,%V", maxThreads, dictionaries1);
+    dataSet<storage_drive> *tokenized_storage = m_Storage_tokenization_mngr->tokenize_multithreaded(dataSet2, "%_,%s,%f,%s,%s,%V", maxThreads, dictionaries2);
 
     printf("tokenized dataset laptops: size: %zu\n",tokenized_laptops->size);
     printf("tokenized dataset storage: size: %zu\n", tokenized_storage->size);
@@ -266,10 +359,31 @@ int main(int argc, char** argv)
     auto elapsedMatch = std::chrono::high_resolution_clock::now() - start;
     printf("time elapsed for matching: %.2f s\n", std::chrono::duration<double>(elapsedMatch).count());
 
+    if (!output_paths[0].empty() || !output_paths[1].empty())
+    {
+        start = std::chrono::high_resolution_clock::now();
+        if (!output_paths[0].empty())
+            Output_mngr::write_matches(output_paths[0], matchesDS1, Output_mngr::format_from_path(output_paths[0]), maxThreads, write_clusters);
+        if (!output_paths[1].empty())
+            Output_mngr::write_matches(output_paths[1], matchesDS2, Output_mngr::format_from_path(output_paths[1]), maxThreads, write_clusters);
+        printf("time elapsed for writing matches: %.2f s\n", std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count());
+    }
+
     start = std::chrono::high_resolution_clock::now();
 
-    float DS1EvaluationScore = m_evaluation_mngr->evaluateMatches(matchesDS1, dataSetSol1);
-    float DS2EvaluationScore = m_evaluation_mngr->evaluateMatches(matchesDS2, dataSetSol2);
+    float DS1EvaluationScore = m_evaluation_mngr->evaluateMatches(matchesDS1, *dataSetSol1);
+    float DS2EvaluationScore = m_evaluation_mngr->evaluateMatches(matchesDS2, *dataSetSol2);
+
+    // binär geschriebene Ergebnisse zusätzlich direkt aus der gemappten Datei auswerten
+    Column_set* solutions[2] = {dataSetSol1, dataSetSol2};
+    for (int k = 0; k < 2; ++k)
+    {
+        if (!output_paths[k].empty() && Output_mngr::format_from_path(output_paths[k]) == Output_mngr::output_binary)
+        {
+            Result_file result(output_paths[k]);
+            m_evaluation_mngr->evaluateMatches(result, *solutions[k]);
+        }
+    }
     
     auto elapsedEval = std::chrono::high_resolution_clock::now() - start;
     printf("time elapsed for evaluation: %.2f s\n", 
@@ -366,6 +480,11 @@ int main(int argc, char** argv)
             delete dataSet2;
         }
 
+        delete dataSetSol1;
+        delete dataSetSol2;
+        delete dictionaries1;
+        delete dictionaries2;
+
         // Manager aufräumen
         delete m_Laptop_tokenization_mngr;
         delete m_Storage_tokenization_mngr;
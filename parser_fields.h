@@ -0,0 +1,534 @@
+#ifndef PARSER_FIELDS_H
+#define PARSER_FIELDS_H
+
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <stdio.h>
+#include "constants.h"
+#include "Utillity.h"
+
+// Feld-Parser für das Format-Literal ("%_,%s,%f,%s,%s,%V", TSV und JSONL siehe format_dialect in Utillity.h).
+// Werden sowohl vom eingebauten Parser (static_parser.h, zur Build-Zeit expandiert) als auch vom JIT-Template
+// (parser_template.cpp) benutzt.
+
+#ifndef COPY_STRING_FIELDS
+#define COPY_STRING_FIELDS 0  // 0 = Pointer merken, 1 = eigene Kopie (copy_text_field)
+#endif
+
+// #define PRINT_FILE_OUTPUT 1  // definiert -> Ausgabe in Datei 
+
+// Die Eingabe wird nur gelesen (read-only Mapping). Normalisierte Texte landen im String-Arena-Bereich
+// des Threads (text), die Felder zeigen dorthin, die Länge steht davor (text_length, field_text).
+
+// COPY_STRING_FIELDS: eigene Kopie samt Längenpräfix
+inline const char* copy_text_field(const char* field)
+{
+    size_t bytes = text_prefix + text_length(field) + 1;
+    char* copy = (char*)malloc(bytes);
+    memcpy(copy, field - text_prefix, bytes);
+    return copy + text_prefix;
+}
+
+// --- Zahlen ohne strtod/strtol ---
+// strtol/strtod prüfen Locale, Leerzeichen, Basis, Hex-Floats usw. für jede Zeile. Die Felder der Eingaben
+// sind einfache Dezimalzahlen: die werden hier direkt gelesen, alles andere geht an strtol/strtod.
+
+// Anzahl führender Ziffern in den 8 Bytes ab p (SWAR, Little Endian). Ein Borgen bzw. Übertrag wandert nur
+// zu höheren Bytes, das niedrigste Nicht-Ziffern-Byte ist also immer korrekt markiert.
+inline unsigned leading_digits8(uint64_t chunk)
+{
+    uint64_t non_digit = ((chunk + 0x4646464646464646ull) | (chunk - 0x3030303030303030ull)) & 0x8080808080808080ull;
+    return non_digit ? __builtin_ctzll(non_digit) / 8 : 8;
+}
+
+// Wert von 8 Ziffern (Bytes 0..9, erstes Byte = höchste Stelle) mit drei Multiplikationen
+inline uint64_t eight_digits_value(uint64_t chunk)
+{
+    chunk = (chunk * 10) + (chunk >> 8);
+    return (((chunk & 0x000000FF000000FFull) * 0x000F424000000064ull)
+          + (((chunk >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+}
+
+// Liest bis zu 19 Ziffern ab p nach value, gibt die Anzahl gelesener Ziffern zurück (mehr Ziffern werden
+// nicht gelesen). 8 Bytes werden nur geladen, wenn sie in derselben Seite liegen wie p.
+inline unsigned parse_digits(const char* p, uint64_t& value)
+{
+    value = 0;
+    unsigned count = 0;
+    while (count + 8 <= 19 && ((uintptr_t)(p + count) & 4095) <= 4096 - 8)
+    {
+        uint64_t chunk;
+        memcpy(&chunk, p + count, 8);
+        unsigned digits = leading_digits8(chunk);
+        chunk -= 0x3030303030303030ull; // Borgen der Nicht-Ziffern wandert nur in höhere, verworfene Bytes
+        if (digits == 8)
+        {
+            value = value * 100000000 + eight_digits_value(chunk);
+            count += 8;
+            continue;
+        }
+        if (digits != 0)
+        {
+            static const uint64_t scale[8] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+            value = value * scale[digits] + eight_digits_value(chunk << (8 * (8 - digits))); // führende Nullen
+        }
+        return count + digits;
+    }
+    while (count < 19 && (unsigned)(p[count] - '0') < 10)
+        value = value * 10 + (p[count++] - '0');
+    return count;
+}
+
+// Ganzzahl wie strtol(p, &end, 10) für [+-]Ziffern; Leerzeichen, Überlauf usw. übernimmt strtol
+inline long parse_long(const char* p, const char** end)
+{
+    const char* q = p;
+    bool negative = (*q == '-');
+    q += (*q == '-' || *q == '+');
+    uint64_t value;
+    unsigned digits = parse_digits(q, value);
+    if (digits == 0 || digits > 18)
+        return strtol(p, (char**)end, 10);
+    *end = q + digits;
+    return negative ? -(long)value : (long)value;
+}
+
+// Gleitkommazahl wie strtod(p, &end) für [+-]Ziffern[.Ziffern][e[+-]Ziffern]. Schneller Pfad nach Clinger:
+// Mantisse bis 2^53 und Zehnerexponent bis 22 sind exakt als double darstellbar, eine Multiplikation bzw.
+// Division rundet dann korrekt. Alles andere (lange Mantissen, inf/nan, Hex) geht an strtod.
+inline double parse_double(const char* p, const char** end)
+{
+    static const double powers_of_ten[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                             1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* q = p;
+    bool negative = (*q == '-');
+    q += (*q == '-' || *q == '+');
+
+    uint64_t mantissa;
+    unsigned int_digits = parse_digits(q, mantissa);
+    q += int_digits;
+    unsigned frac_digits = 0;
+    if (*q == '.')
+    {
+        uint64_t fraction;
+        frac_digits = parse_digits(q + 1, fraction);
+        if (int_digits + frac_digits > 19)
+            return strtod(p, (char**)end);
+        static const uint64_t scale[20] = {1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+                                           100000000ull, 1000000000ull, 10000000000ull, 100000000000ull,
+                                           1000000000000ull, 10000000000000ull, 100000000000000ull,
+                                           1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+                                           1000000000000000000ull, 10000000000000000000ull};
+        mantissa = mantissa * scale[frac_digits] + fraction;
+        q += 1 + frac_digits;
+    }
+    if (int_digits + frac_digits == 0 || int_digits == 19)
+        return strtod(p, (char**)end);
+
+    int exponent = -(int)frac_digits;
+    if (*q == 'e' || *q == 'E')
+    {
+        const char* e = q + 1;
+        bool negative_exponent = (*e == '-');
+        e += (*e == '-' || *e == '+');
+        uint64_t value;
+        unsigned digits = parse_digits(e, value);
+        if (digits == 0 || digits > 4)
+            return strtod(p, (char**)end);
+        exponent += negative_exponent ? -(int)value : (int)value;
+        q = e + digits;
+    }
+    // Zeichen, mit denen strtod weiterlesen würde (Hex, inf/nan, weitere Ziffern)
+    if ((unsigned)(*q - '0') < 10 || *q == '.' || ((*q | 0x20) >= 'a' && (*q | 0x20) <= 'z'))
+        return strtod(p, (char**)end);
+    if (mantissa > (1ull << 53) || exponent < -22 || exponent > 22)
+        return strtod(p, (char**)end);
+
+    double value = (double)mantissa;
+    value = exponent < 0 ? value / powers_of_ten[-exponent] : value * powers_of_ten[exponent];
+    *end = q;
+    return negative ? -value : value;
+}
+
+// --- Abschnitt für %s (String-Feld) ---
+// Sep: Feldtrennzeichen des Formats (',' bei CSV, '\t' bei TSV), gilt ebenso für %f, %d, %_, %*, %V
+template <char Sep = ','>
+inline void parse_field_s(const char*& p, uintptr_t* fields, int idx, char*& text)
+{
+    if (*p == Sep || *p == '\n' || *p == '\0' || *p == '\r') {
+        fields[idx] = (uintptr_t)empty_text;
+        if (*p == Sep) ++p;
+    } else {
+        const char* start = text + text_prefix;
+        const char* end = copy_clean_csv<Sep>(p, text);
+
+        fields[idx] = (uintptr_t)(
+            COPY_STRING_FIELDS ? copy_text_field(start) : start
+        );
+
+        p = end;
+        if (*p == Sep) ++p;
+    }
+}
+
+
+// --- Abschnitt für %f (Double-Feld) ---
+template <char Sep = ','>
+inline void parse_field_f(const char*& p, uintptr_t* fields, int idx, [[maybe_unused]] const char* line) {
+    if (*p == Sep || *p == '\n' || *p == '\0' || *p == '\r') {
+        // Leeres Feld => 0.0
+        double zero = 0.0;
+        uintptr_t bits;
+        memcpy(&bits, &zero, sizeof(zero));
+        fields[idx] = bits;
+        if (*p == Sep) ++p;
+        return;
+    }
+
+    // Float-Wert parsen
+    const char* end;
+    double val = parse_double(p, &end);
+    uintptr_t bits;
+    memcpy(&bits, &val, sizeof(val));
+    fields[idx] = bits;
+    p = end;
+    if (*p == Sep) ++p;
+}
+
+
+// --- Abschnitt für %d (Integer-Feld) ---
+template <char Sep = ','>
+inline void parse_field_d(const char*& p, uintptr_t* fields, int idx, [[maybe_unused]] const char* line)
+{
+    // Überspringe ggf. Leerzeichen
+    if (*p == Sep || *p == '\n' || *p == '\0' || *p == '\r') {
+        fields[idx] = 0;
+        if (*p == Sep) ++p;
+    } else {
+        const char* endptr;
+        long value = parse_long(p, &endptr);  // liest Integer, schreibt neue Position nach endptr
+
+        fields[idx] = (uintptr_t)value;
+        //fprintf(outbuffer,"[%p]: found %ld at %ld\n",p,value, p - line);
+        p = endptr; // weiter nach Zahl
+
+        if (*p == Sep) ++p;
+    }
+}
+
+// --- Abschnitt für %_ (ignore) ---
+template <char Sep = ','>
+inline void parse_field_ignore(const char*& p, [[maybe_unused]] const char* line)
+{
+    // Anführungszeichen und Feldende über die 64-Byte-Masken suchen (simd_skip_field)
+    p = simd_skip_field<Sep>(p);
+    if (*p == Sep) ++p;
+}
+
+// --- Abschnitt für %* (Spalte wird vom Verbraucher nicht gelesen: Slot bleibt, Feld wird nur übersprungen) ---
+template <char Sep = ','>
+inline void parse_field_skip(const char*& p, uintptr_t* fields, int idx, const char* line)
+{
+    fields[idx] = 0;
+    parse_field_ignore<Sep>(p, line);
+}
+
+
+// --- Abschnitt für %V (Rest der Zeile als String) ---
+template <char Sep = ','>
+inline void parse_field_V(const char*& p, uintptr_t* fields, int idx, char*& text) 
+{
+    if (*p == '\n' || *p == '\0' || *p == '\r') {
+        fields[idx] = (uintptr_t)empty_text;
+        //fprintf(outbuffer, "[parser] Leeres V-Feld erkannt\n");
+        return;
+    }
+
+    const char* start = text + text_prefix;
+    const char* end = copy_clean_csv<Sep>(p, text); // mit Länge und nullterminiert im Arena-Bereich
+
+    fields[idx] = (uintptr_t)(
+        COPY_STRING_FIELDS ? copy_text_field(start) : start
+    );
+    p = end + 1;  // weiter zum nächsten Feld oder '\0'
+}
+
+
+// --- JSONL: ein Objekt pro Zeile, Felder über ihren Namen ({"id":%_,"name":%s,"price":%f}) ---
+// Das Schema (Name, Feldtyp, Slot) entsteht aus dem Format: zur Build-Zeit in static_parser.h, beim JIT als
+// Tabelle im erzeugten Quelltext (Parser_mngr::generate_code). Strings werden über die 64-Byte-Masken
+// (simd_find_json_special) bis zum nächsten '"' bzw. '\\' durchlaufen und wie CSV-Felder normalisiert.
+
+struct jsonl_field {
+    const char* key = nullptr;
+    uint32_t length = 0;
+    char kind = 0;  // 's', 'V', 'f', 'd', '*' oder '_' wie im Format
+    int slot = -1;  // -1 bei %_
+};
+
+// Liest das Schema eines JSONL-Formats nach out (nullptr: nur zählen), gibt die Zahl der Felder zurück.
+// constexpr für static_parser.h; ein fehlerhaftes Format wirft dort einen Compilerfehler.
+constexpr size_t parse_jsonl_format(const char* format, size_t size, jsonl_field* out)
+{
+    size_t count = 0;
+    int slot = 0;
+    size_t i = 0;
+    while (i < size && format[i] != '"')
+        ++i;
+    while (i < size)
+    {
+        size_t key = i + 1;
+        size_t key_end = key;
+        while (key_end < size && format[key_end] != '"')
+            ++key_end;
+        if (key_end + 3 >= size || format[key_end + 1] != ':' || format[key_end + 2] != '%')
+            throw "JSONL-Format: erwartet \"name\":%x";
+        char kind = format[key_end + 3];
+        if (out)
+            out[count] = {format + key, (uint32_t)(key_end - key), kind, kind == '_' ? -1 : slot};
+        slot += kind != '_';
+        ++count;
+        i = key_end + 4;
+        while (i < size && format[i] != '"')
+            ++i;
+    }
+    return count;
+}
+
+inline const char* skip_json_space(const char* p)
+{
+    while (*p == ' ' || *p == '\t' || *p == '\r')
+        ++p;
+    return p;
+}
+
+// p steht auf dem öffnenden '"', gibt die Position hinter dem schließenden '"' zurück
+inline const char* skip_json_string(const char* p)
+{
+    ++p;
+    while (true)
+    {
+        p = simd_find_json_special(p);
+        if (*p == '"')
+            return p + 1;
+        if (*p != '\\')
+            return p; // Zeilenende: String nicht geschlossen
+        p += p[1] == '\0' || p[1] == '\n' ? 1 : 2;
+    }
+}
+
+// Beliebiger JSON-Wert ab p (auch Objekte und Arrays), gibt die Position dahinter zurück
+inline const char* skip_json_value(const char* p)
+{
+    int depth = 0;
+    while (*p && *p != '\n')
+    {
+        char c = *p;
+        if (c == '"')
+        {
+            p = skip_json_string(p);
+            if (depth == 0)
+                return p;
+            continue;
+        }
+        if (c == '{' || c == '[')
+            ++depth;
+        else if (c == '}' || c == ']')
+        {
+            if (depth == 0)
+                return p;
+            if (--depth == 0)
+                return p + 1;
+        }
+        else if (depth == 0 && (c == ',' || c == ' ' || c == '\t' || c == '\r'))
+            return p;
+        ++p;
+    }
+    return p;
+}
+
+// Wert von 4 Hexziffern ab p, -1 wenn eine davon keine Hexziffer ist
+inline int json_hex4(const char* p)
+{
+    int value = 0;
+    for (int k = 0; k < 4; ++k)
+    {
+        char c = p[k];
+        char lower = c | 0x20;
+        int digit = (c >= '0' && c <= '9') ? c - '0' : (lower >= 'a' && lower <= 'f') ? lower - 'a' + 10 : -1;
+        if (digit < 0)
+            return -1;
+        value = value * 16 + digit;
+    }
+    return value;
+}
+
+// Eine Escape-Sequenz ab p ('\\') nach dst: \" wird wie "" bei CSV zu Escape, \uXXXX (auch Surrogatpaare)
+// wird als UTF-8 normalisiert (Umlaute transliteriert), alle anderen wie das Zeichen selbst über lut.
+// Schreibt höchstens so viele Bytes, wie die Sequenz lang ist.
+inline const char* copy_json_escape(const char* p, char*& dst)
+{
+    char c = p[1];
+    if (c == '"')
+    {
+        *dst++ = Escape;
+        return p + 2;
+    }
+    if (c == '\0' || c == '\n')
+        return p + 1;
+    if (c != 'u')
+    {
+        char raw = c == 'n' ? '\n' : c == 't' ? '\t' : c == 'r' ? '\r' : c == 'b' ? '\b' : c == 'f' ? '\f' : c;
+        *dst++ = lut[(unsigned char)raw];
+        return p + 2;
+    }
+
+    int codepoint = json_hex4(p + 2);
+    if (codepoint < 0)
+    {
+        *dst++ = whitespace;
+        return p + 2;
+    }
+    p += 6;
+    if (codepoint >= 0xD800 && codepoint < 0xDC00 && p[0] == '\\' && p[1] == 'u')
+    {
+        int low = json_hex4(p + 2);
+        if (low >= 0xDC00 && low < 0xE000)
+        {
+            codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+            p += 6;
+        }
+    }
+
+    char utf8[4];
+    size_t length;
+    if (codepoint < 0x80)
+        utf8[0] = (char)codepoint, length = 1;
+    else if (codepoint < 0x800)
+        utf8[0] = (char)(0xC0 | (codepoint >> 6)), utf8[1] = (char)(0x80 | (codepoint & 0x3F)), length = 2;
+    else if (codepoint < 0x10000)
+        utf8[0] = (char)(0xE0 | (codepoint >> 12)), utf8[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F)), utf8[2] = (char)(0x80 | (codepoint & 0x3F)), length = 3;
+    else
+        utf8[0] = (char)(0xF0 | (codepoint >> 18)), utf8[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F)), utf8[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F)), utf8[3] = (char)(0x80 | (codepoint & 0x3F)), length = 4;
+    dst += simd_normalize_utf8(utf8, dst, length);
+    return p;
+}
+
+// JSON-String ab p ('"') normalisiert nach text, Aufbau wie bei copy_clean_csv (Längenpräfix, Bytes, '\0').
+// Gibt die Position hinter dem schließenden '"' zurück.
+inline const char* copy_json_string(const char* p, char*& text)
+{
+    char* dst = text + text_prefix;
+    ++p;
+    while (true)
+    {
+        const char* special = simd_find_json_special(p);
+        dst += simd_normalize_utf8(p, dst, special - p);
+        p = special;
+        if (*p != '\\')
+        {
+            p += *p == '"';
+            break;
+        }
+        p = copy_json_escape(p, dst);
+    }
+
+    uint32_t length = dst - (text + text_prefix);
+    memcpy(text, &length, sizeof(length));
+    *dst++ = '\0';
+    text = dst;
+    return p;
+}
+
+// Ein Wert des Schemas nach fields[slot]. Texte: Strings normalisiert, andere Skalare (Zahlen, true)
+// als ihr Quelltext, null, Objekte und Arrays leer. Zahlen dürfen auch in Anführungszeichen stehen.
+inline const char* parse_json_value(const char* p, uintptr_t* fields, char kind, int slot, char*& text)
+{
+    if (kind == 's' || kind == 'V')
+    {
+        fields[slot] = (uintptr_t)empty_text;
+        if (*p == '{' || *p == '[' || *p == 'n')
+            return skip_json_value(p);
+        const char* start = text + text_prefix;
+        if (*p == '"')
+            p = copy_json_string(p, text);
+        else
+        {
+            const char* end = skip_json_value(p);
+            char* dst = text + text_prefix;
+            dst += simd_normalize_utf8(p, dst, end - p);
+            uint32_t length = dst - start;
+            memcpy(text, &length, sizeof(length));
+            *dst++ = '\0';
+            text = dst;
+            p = end;
+        }
+        fields[slot] = (uintptr_t)(COPY_STRING_FIELDS ? copy_text_field(start) : start);
+        return p;
+    }
+
+    const char* number = p + (*p == '"');
+    const char* end;
+    if (kind == 'f')
+    {
+        double value = (*number == 'n' || *number == '"') ? 0.0 : parse_double(number, &end);
+        memcpy(&fields[slot], &value, sizeof(value));
+    }
+    else if (kind == 'd')
+        fields[slot] = (*number == 'n' || *number == '"') ? 0 : (uintptr_t)parse_long(number, &end);
+    else
+        fields[slot] = 0; // %*
+    return skip_json_value(p);
+}
+
+// Parst ein JSON-Objekt ab p (eine Zeile) nach fields. Namen, die nicht im Schema stehen, und Felder mit %_
+// werden übersprungen, Felder des Schemas, die im Objekt fehlen, bleiben leer bzw. 0; ein Name, der mehrfach
+// vorkommt, zählt mit seinem letzten Wert. Gibt das Zeilenende ('\n' oder '\0') zurück.
+inline const char* parse_jsonl_record(const char* p, uintptr_t* fields, char*& text, const jsonl_field* schema, size_t count)
+{
+    for (size_t f = 0; f < count; ++f)
+    {
+        if (schema[f].slot >= 0)
+            fields[schema[f].slot] = (schema[f].kind == 's' || schema[f].kind == 'V') ? (uintptr_t)empty_text : 0; // 0 ist auch 0.0
+    }
+
+    p = skip_json_space(p);
+    if (*p != '{')
+        return simd_find_line_end(p);
+    ++p;
+    while (true)
+    {
+        p = skip_json_space(p);
+        if (*p != '"')
+            break; // '}' oder kein Name
+        const char* key = p + 1;
+        p = skip_json_string(p);
+        if (p == key || p[-1] != '"')
+            break;
+        size_t key_length = p - 1 - key;
+        p = skip_json_space(p);
+        if (*p != ':')
+            break;
+        p = skip_json_space(p + 1);
+
+        const jsonl_field* field = nullptr;
+        for (size_t f = 0; f < count && !field; ++f)
+        {
+            if (schema[f].length == key_length && memcmp(schema[f].key, key, key_length) == 0)
+                field = &schema[f];
+        }
+        if (field && field->slot >= 0)
+            p = parse_json_value(p, fields, field->kind, field->slot, text);
+        else
+            p = skip_json_value(p);
+
+        p = skip_json_space(p);
+        if (*p != ',')
+            break;
+        ++p;
+    }
+    return simd_find_line_end(p);
+}
+
+#endif
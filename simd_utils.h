@@ -0,0 +1,536 @@
+#ifndef SIMD_UTILS_H
+#define SIMD_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "constants.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Vektorisierte Hilfsfunktionen für das Einlesen der Dateien.
+// Welche Variante benutzt wird, entscheidet der Compiler anhand der Build-Flags:
+// mit -march=native (bzw. -mavx2) wird AVX2 benutzt, auf x86_64 sonst immer SSE2,
+// auf allen anderen Plattformen der skalare Fallback.
+
+// Liefert eine Bitmaske über 64 Bytes ab p: Bit i gesetzt <=> p[i] == c
+inline uint64_t simd_eq_mask64(const char* p, char c)
+{
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi8(c);
+    __m256i lo = _mm256_loadu_si256((const __m256i*)p);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)(p + 32));
+    uint64_t m_lo = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle));
+    uint64_t m_hi = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle));
+    return m_lo | (m_hi << 32);
+#elif defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int k = 0; k < 4; ++k)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + 16 * k));
+        mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)) << (16 * k);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (int k = 0; k < 64; ++k)
+        mask |= (uint64_t)(p[k] == c) << k;
+    return mask;
+#endif
+}
+
+// Strukturzeichen eines CSV-Feldes über 64 Bytes ab p (Bit i <=> p[i] ist eines der Zeichen).
+// Ein Vergleich pro Zeichen und Register, die Masken werden danach nur noch mit Bitoperationen ausgewertet.
+// Sep ist das Feldtrennzeichen (',' bei CSV, '\t' bei TSV).
+struct csv_structure64 {
+    uint64_t quotes;     // '"'
+    uint64_t delimiters; // Sep, '\n', '\r', '\0' (Feldende außerhalb von Anführungszeichen)
+};
+
+template <char Sep = ','>
+inline csv_structure64 simd_csv_structure64(const char* p)
+{
+#if defined(__AVX2__)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i comma = _mm256_set1_epi8(Sep);
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i carriage = _mm256_set1_epi8('\r');
+    const __m256i zero = _mm256_setzero_si256();
+    csv_structure64 s = {0, 0};
+    for (int k = 0; k < 2; ++k)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + 32 * k));
+        __m256i delim = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, comma), _mm256_cmpeq_epi8(v, newline)),
+                                        _mm256_or_si256(_mm256_cmpeq_epi8(v, carriage), _mm256_cmpeq_epi8(v, zero)));
+        s.quotes |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote)) << (32 * k);
+        s.delimiters |= (uint64_t)(uint32_t)_mm256_movemask_epi8(delim) << (32 * k);
+    }
+    return s;
+#elif defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i comma = _mm_set1_epi8(Sep);
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriage = _mm_set1_epi8('\r');
+    const __m128i zero = _mm_setzero_si128();
+    csv_structure64 s = {0, 0};
+    for (int k = 0; k < 4; ++k)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + 16 * k));
+        __m128i delim = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, newline)),
+                                     _mm_or_si128(_mm_cmpeq_epi8(v, carriage), _mm_cmpeq_epi8(v, zero)));
+        s.quotes |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)) << (16 * k);
+        s.delimiters |= (uint64_t)(uint16_t)_mm_movemask_epi8(delim) << (16 * k);
+    }
+    return s;
+#else
+    csv_structure64 s = {0, 0};
+    for (int k = 0; k < 64; ++k)
+    {
+        char c = p[k];
+        s.quotes |= (uint64_t)(c == '"') << k;
+        s.delimiters |= (uint64_t)(c == Sep || c == '\n' || c == '\r' || c == '\0') << k;
+    }
+    return s;
+#endif
+}
+
+// Die Scanner suchen bis zu einem Terminator ('\0') und kennen das Pufferende nicht. Ab dem ersten auf 64 Bytes
+// ausgerichteten Block hinter p lesen sie nur ganze, ausgerichtete Blöcke: ein solcher Block liegt nie auf zwei
+// Seiten, daher wird höchstens bis zum Ende der Seite gelesen, in der der Terminator steht.
+// Vor p wird nie gelesen (Puffer aus new[] sind nur auf 16 Bytes ausgerichtet): der Anfang bis zum ersten
+// ausgerichteten Block wird ungeausgerichtet ab p geladen, wenn die 64 Bytes in derselben Seite liegen, sonst
+// über eine Kopie der restlichen Bytes der Seite (die Lücke mit einem Byte gefüllt, das keine Maske trifft).
+// block_mask(q) liefert die Bitmaske der gesuchten Zeichen über die 64 Bytes ab q.
+template <typename BlockMask>
+inline const char* simd_find_first(const char* p, BlockMask block_mask)
+{
+    const char* block = (const char*)(((uintptr_t)p + 63) & ~(uintptr_t)63);
+    if (block != p)
+    {
+        uint64_t mask;
+        if (((uintptr_t)p & 4095) <= 4096 - 64)
+            mask = block_mask(p);
+        else
+        {
+            alignas(64) char head[64];
+            size_t valid = block - p;
+            memcpy(head, p, valid);
+            memset(head + valid, 'a', 64 - valid);
+            mask = block_mask(head) & ((1ull << valid) - 1);
+        }
+        if (mask)
+            return p + __builtin_ctzll(mask);
+    }
+    uint64_t mask;
+    while (!(mask = block_mask(block)))
+        block += 64;
+    return block + __builtin_ctzll(mask);
+}
+
+// Erstes Feldende (Sep, '\n', '\r' oder '\0') ab p, Anführungszeichen werden nicht beachtet
+template <char Sep = ','>
+inline const char* simd_find_delimiter(const char* p)
+{
+    return simd_find_first(p, [](const char* q) { return simd_csv_structure64<Sep>(q).delimiters; });
+}
+
+// Erstes '"' oder '\0' ab p
+inline const char* simd_find_quote(const char* p)
+{
+    return simd_find_first(p, [](const char* q) { return simd_eq_mask64(q, '"') | simd_eq_mask64(q, '\0'); });
+}
+
+// Ende eines Feldes ab p (p steht auf dem Feldanfang): bei '"' zuerst das schließende Anführungszeichen
+// ("" ist ein maskiertes Zeichen), danach das nächste Feldende. Wie der frühere byteweise Ablauf.
+template <char Sep = ','>
+inline const char* simd_skip_field(const char* p)
+{
+    if (*p == '"')
+    {
+        ++p;
+        while (true)
+        {
+            p = simd_find_quote(p);
+            if (*p == '\0')
+                return p;
+            if (p[1] != '"')
+            {
+                ++p;
+                break;
+            }
+            p += 2;
+        }
+    }
+    return simd_find_delimiter<Sep>(p);
+}
+
+// Erstes '"', '\\', '\n' oder '\0' ab p: Ende bzw. nächste Escape-Sequenz eines JSON-Strings (JSONL-Parser).
+// Ein rohes '\n' ist in JSON-Strings nicht erlaubt, ein nicht geschlossener String endet damit an der Zeile.
+inline const char* simd_find_json_special(const char* p)
+{
+    return simd_find_first(p, [](const char* q) {
+        return simd_eq_mask64(q, '"') | simd_eq_mask64(q, '\\') | simd_eq_mask64(q, '\n') | simd_eq_mask64(q, '\0');
+    });
+}
+
+// Erstes '\n' oder '\0' ab p (Ende eines JSONL-Datensatzes)
+inline const char* simd_find_line_end(const char* p)
+{
+    return simd_find_first(p, [](const char* q) { return simd_eq_mask64(q, '\n') | simd_eq_mask64(q, '\0'); });
+}
+
+// Zählt alle '\n' im Bereich [p, p + n)
+inline size_t count_newlines(const char* p, size_t n)
+{
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+        count += __builtin_popcountll(simd_eq_mask64(p + i, '\n'));
+    for (; i < n; ++i)
+        count += (p[i] == '\n');
+    return count;
+}
+
+// Bit i des Ergebnisses = XOR der Bits 0..i von x (markiert die Bytes zwischen öffnendem und schließendem '"')
+inline uint64_t prefix_xor64(uint64_t x)
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// Bit i <=> p[i] liegt innerhalb von Anführungszeichen (das öffnende '"' zählt dazu, das schließende nicht).
+// in_quotes ist der Zustand vor dem Block (0 oder ~0) und wird auf den Zustand danach gesetzt.
+// quote: Zeichen, das Zeilenumbrüche in Feldern maskiert; '\0' bei Formaten ohne solche Felder (JSONL, siehe
+// record_quote in Utillity.h), dann liegt kein Byte innerhalb und jedes '\n' beendet einen Datensatz.
+inline uint64_t simd_quoted_mask64(const char* p, uint64_t& in_quotes, char quote = '"')
+{
+    if (!quote)
+        return in_quotes = 0;
+    uint64_t inside = prefix_xor64(simd_eq_mask64(p, quote)) ^ in_quotes;
+    in_quotes = (uint64_t)((int64_t)inside >> 63);
+    return inside;
+}
+
+// Offset direkt hinter dem letzten '\n' in [p, p + n), das nicht in Anführungszeichen steht.
+// p muss auf einem Datensatzanfang stehen. Gibt 0 zurück, wenn kein Datensatz vollständig ist.
+inline size_t last_record_end(const char* p, size_t n, char quote = '"')
+{
+    uint64_t in_quotes = 0;
+    size_t last = 0;
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        uint64_t record_ends = simd_eq_mask64(p + i, '\n') & ~simd_quoted_mask64(p + i, in_quotes, quote);
+        if (record_ends)
+            last = i + (63 - __builtin_clzll(record_ends)) + 1;
+    }
+    bool quoted = in_quotes != 0;
+    for (; i < n; ++i)
+    {
+        if (quote && p[i] == quote)
+            quoted = !quoted;
+        else if (p[i] == '\n' && !quoted)
+            last = i + 1;
+    }
+    return last;
+}
+
+// Ergebnis eines Durchlaufs über einen Block, dessen Anführungszeichen-Zustand am Anfang noch unbekannt ist.
+// Beide Fälle fallen in einem Durchlauf ab: beginnt der Block innerhalb von Anführungszeichen, kehrt sich
+// die Maske nur um, die Datensatzenden sind dann die übrigen '\n' (newlines - record_ends).
+struct quote_scan {
+    bool odd_quotes;    // ungerade Anzahl '"': Zustand am Blockende ist umgekehrt zu dem am Anfang
+    size_t newlines;    // alle '\n'
+    size_t record_ends; // '\n' außerhalb von Anführungszeichen, wenn der Block außerhalb beginnt
+};
+
+inline quote_scan scan_quotes(const char* p, size_t n, char quote = '"')
+{
+    quote_scan scan = {false, 0, 0};
+    uint64_t in_quotes = 0;
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        uint64_t newlines = simd_eq_mask64(p + i, '\n');
+        scan.newlines += __builtin_popcountll(newlines);
+        scan.record_ends += __builtin_popcountll(newlines & ~simd_quoted_mask64(p + i, in_quotes, quote));
+    }
+    bool quoted = in_quotes != 0;
+    for (; i < n; ++i)
+    {
+        if (quote && p[i] == quote)
+            quoted = !quoted;
+        else if (p[i] == '\n')
+        {
+            ++scan.newlines;
+            scan.record_ends += !quoted;
+        }
+    }
+    scan.odd_quotes = quoted;
+    return scan;
+}
+
+// Offset des ersten Datensatzanfangs in [p, p + n) (hinter einem '\n' außerhalb von Anführungszeichen),
+// quoted ist der Zustand bei p. Gibt n zurück, wenn im Bereich kein Datensatz beginnt.
+inline size_t next_record_start(const char* p, size_t n, bool quoted, char quote = '"')
+{
+    uint64_t in_quotes = quoted ? ~0ull : 0;
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        uint64_t record_ends = simd_eq_mask64(p + i, '\n') & ~simd_quoted_mask64(p + i, in_quotes, quote);
+        if (record_ends)
+            return i + __builtin_ctzll(record_ends) + 1;
+    }
+    quoted = in_quotes != 0;
+    for (; i < n; ++i)
+    {
+        if (quote && p[i] == quote)
+            quoted = !quoted;
+        else if (p[i] == '\n' && !quoted)
+            return i + 1;
+    }
+    return n;
+}
+
+// Schreibt für jedes '\n' außerhalb von Anführungszeichen in [begin, end) den Offset des folgenden
+// Datensatzanfangs nach out, quoted ist der Zustand bei begin. Ein Zeilenumbruch innerhalb eines
+// Feldes ("Titel\nmit Umbruch") beginnt keinen neuen Datensatz.
+// Gibt die Anzahl geschriebener Offsets zurück (scan_quotes(...).record_ends bzw. newlines - record_ends).
+inline size_t collect_record_starts(const char* buffer, size_t begin, size_t end, bool quoted, size_t* out)
+{
+    uint64_t in_quotes = quoted ? ~0ull : 0;
+    size_t written = 0;
+    size_t i = begin;
+    for (; i + 64 <= end; i += 64)
+    {
+        uint64_t mask = simd_eq_mask64(buffer + i, '\n') & ~simd_quoted_mask64(buffer + i, in_quotes);
+        while (mask)
+        {
+            out[written++] = i + __builtin_ctzll(mask) + 1;
+            mask &= mask - 1;
+        }
+    }
+    quoted = in_quotes != 0;
+    for (; i < end; ++i)
+    {
+        if (buffer[i] == '"')
+            quoted = !quoted;
+        else if (buffer[i] == '\n' && !quoted)
+            out[written++] = i + 1;
+    }
+    return written;
+}
+
+// Normalisierung wie lut (constants.h), 16 bzw. 32 Bytes pro Schritt: Buchstaben klein, Ziffern auf 87..96,
+// '.' auf dotToComma, alles andere auf whitespace. Benutzt von copy_clean_csv (Parser) und fimport_token (Tokenlisten).
+// Mit SSSE3/AVX2 werden die Zeichenklassen per pshufb aus zwei 16-Einträge-Tabellen (oberes und unteres
+// Nibble) bestimmt, mit SSE2 allein (kein pshufb) über Bereichsvergleiche. Das Ergebnis ist in allen Varianten
+// bitgleich zu lut. dst == src und dst < src (in-place mit Verdichtung) sind erlaubt.
+//
+// Klassenbits: 0x01 'A'-'O' (ohne '@'), 0x10 'P'-'Z', 0x02 'a'-'o' (ohne '`'), 0x20 'p'-'z', 0x04 Ziffer, 0x08 '.'
+// Klasse = hi_table[c >> 4] & lo_table[c & 15]; Bytes ab 0x80 haben ein oberes Nibble ohne Klasse.
+#if defined(__AVX2__) || defined(__SSSE3__)
+#define NORMALIZE_HI_TABLE 0, 0, 0x08, 0x04, 0x01, 0x10, 0x02, 0x20, 0, 0, 0, 0, 0, 0, 0, 0
+#define NORMALIZE_LO_TABLE 0x34, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x33, 0x03, 0x03, 0x03, 0x0B, 0x03
+#endif
+
+#if defined(__AVX2__)
+inline __m256i normalize32(__m256i v)
+{
+    const __m256i hi_table = _mm256_setr_epi8(NORMALIZE_HI_TABLE, NORMALIZE_HI_TABLE);
+    const __m256i lo_table = _mm256_setr_epi8(NORMALIZE_LO_TABLE, NORMALIZE_LO_TABLE);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i hi = _mm256_shuffle_epi8(hi_table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    __m256i lo = _mm256_shuffle_epi8(lo_table, _mm256_and_si256(v, nibble));
+    __m256i cls = _mm256_and_si256(hi, lo);
+
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i letter = _mm256_xor_si256(_mm256_cmpeq_epi8(_mm256_and_si256(cls, _mm256_set1_epi8(0x33)), zero), _mm256_set1_epi8(-1));
+    __m256i digit = _mm256_cmpeq_epi8(_mm256_and_si256(cls, _mm256_set1_epi8(0x04)), _mm256_set1_epi8(0x04));
+    __m256i dot = _mm256_cmpeq_epi8(_mm256_and_si256(cls, _mm256_set1_epi8(0x08)), _mm256_set1_epi8(0x08));
+    __m256i other = _mm256_cmpeq_epi8(cls, zero);
+
+    __m256i out = _mm256_and_si256(letter, _mm256_or_si256(v, _mm256_set1_epi8(0x20)));
+    out = _mm256_or_si256(out, _mm256_and_si256(digit, _mm256_add_epi8(v, _mm256_set1_epi8(87 - '0'))));
+    out = _mm256_or_si256(out, _mm256_and_si256(dot, _mm256_set1_epi8((char)dotToComma)));
+    return _mm256_or_si256(out, _mm256_and_si256(other, _mm256_set1_epi8((char)whitespace)));
+}
+#endif
+
+#if defined(__SSE2__)
+inline __m128i normalize16(__m128i v)
+{
+    const __m128i zero = _mm_setzero_si128();
+#if defined(__SSSE3__)
+    const __m128i hi_table = _mm_setr_epi8(NORMALIZE_HI_TABLE);
+    const __m128i lo_table = _mm_setr_epi8(NORMALIZE_LO_TABLE);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i cls = _mm_and_si128(_mm_shuffle_epi8(hi_table, _mm_and_si128(_mm_srli_epi16(v, 4), nibble)),
+                                _mm_shuffle_epi8(lo_table, _mm_and_si128(v, nibble)));
+    __m128i letter = _mm_xor_si128(_mm_cmpeq_epi8(_mm_and_si128(cls, _mm_set1_epi8(0x33)), zero), _mm_set1_epi8(-1));
+    __m128i digit = _mm_cmpeq_epi8(_mm_and_si128(cls, _mm_set1_epi8(0x04)), _mm_set1_epi8(0x04));
+    __m128i dot = _mm_cmpeq_epi8(_mm_and_si128(cls, _mm_set1_epi8(0x08)), _mm_set1_epi8(0x08));
+    __m128i other = _mm_cmpeq_epi8(cls, zero);
+#else
+    // Vorzeichenbehaftete Vergleiche: Bytes ab 0x80 sind negativ und fallen aus allen Bereichen
+    auto in_range = [](__m128i x, char low, char high) {
+        return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(low - 1)), _mm_cmplt_epi8(x, _mm_set1_epi8(high + 1)));
+    };
+    __m128i letter = _mm_or_si128(in_range(v, 'A', 'Z'), in_range(v, 'a', 'z'));
+    __m128i digit = in_range(v, '0', '9');
+    __m128i dot = _mm_cmpeq_epi8(v, _mm_set1_epi8('.'));
+    __m128i other = _mm_cmpeq_epi8(_mm_or_si128(_mm_or_si128(letter, digit), dot), zero);
+#endif
+    __m128i out = _mm_and_si128(letter, _mm_or_si128(v, _mm_set1_epi8(0x20)));
+    out = _mm_or_si128(out, _mm_and_si128(digit, _mm_add_epi8(v, _mm_set1_epi8(87 - '0'))));
+    out = _mm_or_si128(out, _mm_and_si128(dot, _mm_set1_epi8((char)dotToComma)));
+    return _mm_or_si128(out, _mm_and_si128(other, _mm_set1_epi8((char)whitespace)));
+}
+#endif
+
+// Schreibt lut[src[i]] nach dst[i] für i < n. Liest und schreibt nie über n hinaus.
+inline void simd_normalize(const char* src, char* dst, size_t n)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= n; i += 32)
+        _mm256_storeu_si256((__m256i*)(dst + i), normalize32(_mm256_loadu_si256((const __m256i*)(src + i))));
+#endif
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16)
+        _mm_storeu_si128((__m128i*)(dst + i), normalize16(_mm_loadu_si128((const __m128i*)(src + i))));
+#endif
+    for (; i < n; ++i)
+        dst[i] = lut[(unsigned char)src[i]];
+}
+
+// ASCII-Schnellpfad von simd_normalize_utf8: normalisiert ab src + i ganze Vektorblöcke (32, dann 16 Bytes),
+// solange sie nur ASCII enthalten. Jeder Block wird einmal geladen; Bit 7 kommt per movemask aus demselben
+// Register, das normalize32/normalize16 umsetzt. i und out stehen danach hinter dem letzten ASCII-Block.
+// Gibt die Bit-7-Maske des Blocks ab src + i zurück, 0 wenn kein vollständiger Block mehr übrig ist.
+// Wie simd_normalize: dst + out <= src + i ist erlaubt (nur bereits geladene Bytes werden überschrieben).
+inline uint32_t normalize_ascii_blocks(const char* src, char* dst, size_t n, size_t& i, size_t& out)
+{
+#if defined(__AVX2__)
+    for (; i + 32 <= n; i += 32, out += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        uint32_t non_ascii = (uint32_t)_mm256_movemask_epi8(v);
+        if (non_ascii)
+            return non_ascii;
+        _mm256_storeu_si256((__m256i*)(dst + out), normalize32(v));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16, out += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        uint32_t non_ascii = (uint32_t)_mm_movemask_epi8(v);
+        if (non_ascii)
+            return non_ascii;
+        _mm_storeu_si128((__m128i*)(dst + out), normalize16(v));
+    }
+#else
+    for (; i + 8 <= n; i += 8, out += 8)
+    {
+        uint32_t non_ascii = 0;
+        for (size_t k = 0; k < 8; ++k)
+            non_ascii |= (uint32_t)((unsigned char)src[i + k] >> 7) << k;
+        if (non_ascii)
+            return non_ascii;
+        for (size_t k = 0; k < 8; ++k)
+            dst[out + k] = lut[(unsigned char)src[i + k]];
+    }
+#endif
+    return 0;
+}
+
+// Eine Nicht-ASCII-Sequenz ab src[i] (i < n): schreibt die Transliteration (translit, constants.h) oder ein
+// whitespace nach dst, setzt i hinter die Sequenz und gibt die Zahl geschriebener Bytes zurück.
+// Ungültige oder abgeschnittene Sequenzen werden byteweise zu whitespace. Nie mehr Bytes als gelesen.
+inline size_t transliterate_utf8(const char* src, size_t n, size_t& i, char* dst)
+{
+    unsigned char lead = (unsigned char)src[i];
+    size_t length = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC2 ? 2 : 0;
+    if (lead > 0xF4 || length == 0 || i + length > n)
+    {
+        ++i;
+        dst[0] = (char)whitespace;
+        return 1;
+    }
+    unsigned codepoint = lead & (0x7F >> length);
+    for (size_t k = 1; k < length; ++k)
+    {
+        unsigned char next = (unsigned char)src[i + k];
+        if ((next & 0xC0) != 0x80)
+        {
+            ++i;
+            dst[0] = (char)whitespace;
+            return 1;
+        }
+        codepoint = (codepoint << 6) | (next & 0x3F);
+    }
+    i += length;
+    if (codepoint >= translit_first && codepoint <= translit_last && translit[codepoint - translit_first][0])
+    {
+        const char* t = translit[codepoint - translit_first];
+        dst[0] = t[0];
+        if (!t[1])
+            return 1;
+        dst[1] = t[1];
+        return 2;
+    }
+    dst[0] = (char)whitespace;
+    return 1;
+}
+
+// UTF-8-fähige Variante von simd_normalize: ASCII wie lut, Umlaute und Akzente werden transliteriert
+// (ä -> ae, ß -> ss, é -> e), Symbole und unbekannte Zeichen zu whitespace. Reine ASCII-Blöcke bleiben
+// auf dem Vektorpfad, nur Blöcke mit gesetztem Bit 7 werden sequenzweise dekodiert.
+// Gibt die Zahl geschriebener Bytes zurück (<= n). dst == src und dst < src sind erlaubt.
+inline size_t simd_normalize_utf8(const char* src, char* dst, size_t n)
+{
+    size_t i = 0;
+    size_t out = 0;
+#if defined(__SSE2__)
+    // Die letzten 16 Bytes vor dem ersten Schreiben laden (dst == src ist erlaubt): ein ASCII-Rest unter
+    // einem Vektorblock wird am Ende als überlappender Block geschrieben statt byteweise
+    __m128i last = n >= 16 ? _mm_loadu_si128((const __m128i*)(src + n - 16)) : _mm_setzero_si128();
+#endif
+    while (uint32_t non_ascii = normalize_ascii_blocks(src, dst, n, i, out))
+    {
+        size_t ascii = __builtin_ctz(non_ascii);
+        simd_normalize(src + i, dst + out, ascii);
+        i += ascii;
+        out += ascii;
+        out += transliterate_utf8(src, n, i, dst + out);
+    }
+#if defined(__SSE2__)
+    // out == i: die Ausgabe ist (wieder) deckungsgleich zur Eingabe, die überlappten Bytes werden mit
+    // denselben Werten überschrieben. Enthält der Block Nicht-ASCII, geht es byteweise weiter.
+    if (i < n && n >= 16 && out == i && !_mm_movemask_epi8(last))
+    {
+        _mm_storeu_si128((__m128i*)(dst + n - 16), normalize16(last));
+        return n;
+    }
+#endif
+    while (i < n)
+    {
+        if ((unsigned char)src[i] < 0x80)
+            dst[out++] = lut[(unsigned char)src[i++]];
+        else
+            out += transliterate_utf8(src, n, i, dst + out);
+    }
+    return out;
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef STATIC_PARSER_H
+#define STATIC_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <string_view>
+#include <utility>
+#include "parser_fields.h"
+
+// Zur Build-Zeit erzeugte Zeilenparser: static_parser<"%_,%s,%f,%s,%s,%V"> expandiert das Format-Literal
+// in dieselbe Folge von parse_field_*-Aufrufen, die Parser_mngr::generate_code für den JIT erzeugt, und hat
+// dieselbe Signatur wie ParserFunc. Ohne g++ zur Laufzeit, ohne parser_N.so, ohne Startkosten.
+//
+// Parser_mngr::create_parser schlägt das Format zuerst in builtin_parsers() nach und kompiliert nur
+// unbekannte Formate per JIT. Neue Formate für den eingebauten Parser in builtin_parsers() eintragen.
+// TSV-Formate ('\t' zwischen den Feldern) benutzen die CSV-Feldparser mit '\t' als Trennzeichen,
+// JSONL-Formate ({"name":%s,...}) ein zur Build-Zeit erzeugtes Schema für parse_jsonl_record.
+
+template <size_t N>
+struct format_literal {
+    char value[N];
+
+    constexpr format_literal(const char (&text)[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+            value[i] = text[i];
+    }
+
+    constexpr std::string_view view() const { return std::string_view(value, N - 1); }
+};
+
+// Feldtypen des Formats in Reihenfolge ('_', 's', 'f', 'd', 'V', '*'), zur Build-Zeit geprüft
+template <format_literal Format>
+constexpr size_t format_field_count()
+{
+    size_t count = 0;
+    std::string_view format = Format.view();
+    for (size_t i = 0; i + 1 < format.size(); ++i)
+        if (format[i] == '%')
+            ++count, ++i;
+    return count;
+}
+
+template <format_literal Format>
+constexpr auto format_fields()
+{
+    std::array<char, format_field_count<Format>()> fields{};
+    std::string_view format = Format.view();
+    size_t count = 0;
+    for (size_t i = 0; i + 1 < format.size(); ++i)
+    {
+        if (format[i] != '%')
+            continue;
+        char kind = format[++i];
+        if (kind != '_' && kind != 's' && kind != 'f' && kind != 'd' && kind != 'V' && kind != '*')
+            throw "unbekannter Feldtyp im Format"; // im constexpr-Kontext ein Compilerfehler
+        fields[count++] = kind;
+    }
+    return fields;
+}
+
+// Dialekt wie detect_dialect (Utillity.h), zur Build-Zeit
+template <format_literal Format>
+constexpr format_dialect static_dialect()
+{
+    std::string_view format = Format.view();
+    if (!format.empty() && format[0] == '{')
+        return dialect_jsonl;
+    return format.find('\t') != std::string_view::npos ? dialect_tsv : dialect_csv;
+}
+
+template <format_literal Format>
+constexpr auto jsonl_schema()
+{
+    std::array<jsonl_field, parse_jsonl_format(Format.value, Format.view().size(), nullptr)> schema{};
+    parse_jsonl_format(Format.value, Format.view().size(), schema.data());
+    return schema;
+}
+
+// Ausgabeslot des Feldes field (ignorierte Felder belegen keinen Slot)
+template <format_literal Format>
+constexpr int format_slot(size_t field)
+{
+    constexpr auto fields = format_fields<Format>();
+    int slot = 0;
+    for (size_t i = 0; i < field; ++i)
+        slot += fields[i] != '_';
+    return slot;
+}
+
+template <char Kind, int Slot, char Sep>
+inline void parse_static_field(const char*& p, uintptr_t* fields, char*& text, const char* line)
+{
+    if constexpr (Kind == '_')
+        parse_field_ignore<Sep>(p, line);
+    else if constexpr (Kind == 's')
+        parse_field_s<Sep>(p, fields, Slot, text);
+    else if constexpr (Kind == 'f')
+        parse_field_f<Sep>(p, fields, Slot, line);
+    else if constexpr (Kind == 'd')
+        parse_field_d<Sep>(p, fields, Slot, line);
+    else if constexpr (Kind == '*')
+        parse_field_skip<Sep>(p, fields, Slot, line);
+    else
+        parse_field_V<Sep>(p, fields, Slot, text);
+}
+
+template <format_literal Format, size_t... I>
+inline void parse_static_fields(const char*& p, uintptr_t* fields, char*& text, const char* line, std::index_sequence<I...>)
+{
+    constexpr auto kinds = format_fields<Format>();
+    constexpr char sep = static_dialect<Format>() == dialect_tsv ? '\t' : ',';
+    (parse_static_field<kinds[I], format_slot<Format>(I), sep>(p, fields, text, line), ...);
+}
+
+// Gleicher Ablauf wie die Hauptfunktion in parser_template.cpp
+template <format_literal Format>
+size_t static_parser(const char* line, void* out, char** text_out)
+{
+    const char* p = line;
+    uintptr_t* fields = (uintptr_t*)out;
+    char* text = *text_out;
+    if constexpr (static_dialect<Format>() == dialect_jsonl)
+    {
+        static constexpr auto schema = jsonl_schema<Format>();
+        p = parse_jsonl_record(p, fields, text, schema.data(), schema.size());
+    }
+    else
+        parse_static_fields<Format>(p, fields, text, line, std::make_index_sequence<format_field_count<Format>()>());
+    while (*p == '\r' || *p == '\n')
+    {++p;}
+    *text_out = text;
+    return p - line;
+}
+
+struct builtin_parser {
+    std::string_view format;
+    size_t (*parse)(const char* line, void* out, char** text_out);
+};
+
+// Formate, die in das Programm einkompiliert sind (Laptops, Storage voll und projiziert, Lösungsdateien;
+// Laptops und projizierte Storage-Datensätze auch als TSV und JSONL mit den Spaltennamen der CSV-Kopfzeilen)
+inline const std::array<builtin_parser, 8>& builtin_parsers()
+{
+    static const std::array<builtin_parser, 8> parsers = {{
+        {"%_,%V", &static_parser<"%_,%V">},
+        {"%_,%s,%f,%s,%s,%V", &static_parser<"%_,%s,%f,%s,%s,%V">},
+        {"%_,%s,%*,%s,%s,%V", &static_parser<"%_,%s,%*,%s,%s,%V">},
+        {"%d,%d", &static_parser<"%d,%d">},
+        {"%_\t%V", &static_parser<"%_\t%V">},
+        {"%_\t%s\t%*\t%s\t%s\t%V", &static_parser<"%_\t%s\t%*\t%s\t%s\t%V">},
+        {"{\"id\":%_,\"title\":%V}", &static_parser<"{\"id\":%_,\"title\":%V}">},
+        {"{\"id\":%_,\"name\":%s,\"price\":%*,\"brand\":%s,\"description\":%s,\"category\":%V}",
+         &static_parser<"{\"id\":%_,\"name\":%s,\"price\":%*,\"brand\":%s,\"description\":%s,\"category\":%V}">},
+    }};
+    return parsers;
+}
+
+#endif
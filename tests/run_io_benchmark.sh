@@ -0,0 +1,24 @@
+#!/bin/bash
+
+# Farben für die Ausgabe
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+RED='\033[0;31m'
+NC='\033[0m' # No Color
+
+cd "$(dirname "$0")"
+
+echo -e "${YELLOW}=== Kompiliere Einlese-Benchmark (mmap/Prefault vs. io_uring) ===${NC}"
+
+g++ -std=c++20 -O3 io_benchmark.cpp -o io_benchmark
+
+if [ $? -eq 0 ]; then
+    echo -e "${GREEN}Kompilierung erfolgreich${NC}"
+
+    # Parameter werden durchgereicht, z.B. ./run_io_benchmark.sh --repeat 200
+    ./io_benchmark "$@"
+    exit $?
+else
+    echo -e "${RED}Kompilierung fehlgeschlagen${NC}"
+    exit 1
+fi
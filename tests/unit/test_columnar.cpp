@@ -0,0 +1,310 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <cstdio>
+#include "../../Parser_mngr.h"
+
+// Storage-Datei mit Kopfzeile, Preisen, leeren Feldern und Texten in Anführungszeichen
+std::string write_storage_csv(const std::string& path, size_t rows)
+{
+    std::string content = "id,brand,price,interface,form,title\n";
+    for (size_t i = 0; i < rows; ++i)
+    {
+        content += std::to_string(i) + ",Brand" + std::to_string(i % 7) + ",";
+        if (i % 5 != 0)
+            content += std::to_string(i % 300) + "." + std::to_string(i % 100);
+        content += ",\"USB \"\"" + std::to_string(i % 4) + "\"\"\",SD,Titel " + std::string(i % 40, 'x') + "\n";
+    }
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+    return content;
+}
+
+// Test: Spalten enthalten dieselben Werte wie die Zeilenvariante, Texte mit Länge, Zahlen typisiert
+void test_columns_match_rows()
+{
+    std::cout << "=== Testing Parser_mngr::parse_columnar ===" << std::endl;
+
+    std::string path = "/tmp/dupdetec_columnar.csv";
+    write_storage_csv(path, 20000);
+    const std::string format = "%_,%s,%f,%s,%s,%V";
+
+    Parser_mngr parser_mngr;
+    File file(path, false);
+    dataSet<quintupel>* rows = parser_mngr.parse_multithreaded<quintupel>(file, format, 4);
+    Column_set* columns = parser_mngr.parse_columnar<5>(file, format, 4);
+
+    assert(columns->size() == rows->size && rows->size == 20000);
+    assert(columns->column_count() == 5);
+    assert((*columns)[0].kind == 's' && (*columns)[1].kind == 'f' && (*columns)[4].kind == 'V');
+    for (size_t i = 0; i < rows->size; ++i)
+    {
+        for (size_t c : {0, 2, 3, 4})
+        {
+            const char* expected = (const char*)rows->data[i].data[c];
+            assert(strcmp((*columns)[c].text[i], expected) == 0);
+            assert((*columns)[c].length[i] == strlen(expected));
+        }
+        double price;
+        memcpy(&price, &rows->data[i].data[1], sizeof(price));
+        assert((*columns)[1].real[i] == price);
+    }
+    assert((*columns)[1].real[0] == 0.0 && (*columns)[1].real[1] == 1.1);
+
+    delete[] rows->data;
+    delete rows;
+    delete columns;
+    std::remove(path.c_str());
+    std::remove((path + ".lidx").c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: ID-Spalten einer Lösungsdatei, falsche Feldzahl wird abgelehnt
+void test_id_columns()
+{
+    std::cout << "\n=== Testing integer columns ===" << std::endl;
+
+    std::string path = "/tmp/dupdetec_columnar_ids.csv";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "lid,rid\n";
+        for (size_t i = 0; i < 5000; ++i)
+            out << i * 3 << "," << i * 3 + 1000000007ull << "\r\n";
+    }
+
+    Parser_mngr parser_mngr;
+    File file(path, false);
+    Column_set* ids = parser_mngr.parse_columnar<2>(file, "%d,%d", 3);
+    assert(ids->size() == 5000);
+    for (size_t i = 0; i < ids->size(); ++i)
+        assert((*ids)[0].integer[i] == (int64_t)(i * 3) && (*ids)[1].integer[i] == (int64_t)(i * 3 + 1000000007ull));
+    delete ids;
+
+    bool rejected = false;
+    try { parser_mngr.parse_columnar<3>(file, "%d,%d", 3); } catch (const std::runtime_error&) { rejected = true; }
+    assert(rejected);
+
+    std::remove(path.c_str());
+    std::remove((path + ".lidx").c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: Spalten entstehen ohne Zeilenpuffer direkt aus vielen kleinen Blöcken; Leerzeilen (Lücken) und
+// überzählige Felder (Überlauf) ergeben dieselben Werte in derselben Reihenfolge wie die Zeilenvariante
+void test_columns_from_chunks()
+{
+    std::cout << "\n=== Testing columnar parse over small chunks ===" << std::endl;
+
+    std::string path = "/tmp/dupdetec_columnar_chunks.csv";
+    for (bool extra_fields : {false, true})
+    {
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << "lid,rid\n";
+            for (size_t i = 0; i < 20000; ++i)
+            {
+                out << i << "," << i * 7;
+                if (extra_fields && i % 1000 == 0)
+                    out << "," << i + 1;
+                out << (!extra_fields && i % 13 == 0 ? "\n\n\n" : "\n"); // Leerzeilen bieten sonst Platz für den Überlauf
+            }
+        }
+
+        const size_t default_chunk_bytes = parse_min_chunk_bytes;
+        parse_min_chunk_bytes = 4096;
+        Parser_mngr parser_mngr;
+        File file(path, false);
+        dataSet<tuple_t<2, uintptr_t>>* rows = parser_mngr.parse_multithreaded<tuple_t<2, uintptr_t>>(file, "%d,%d", 3);
+        Column_set* ids = parser_mngr.parse_columnar<2>(file, "%d,%d", 3);
+        parse_min_chunk_bytes = default_chunk_bytes;
+
+        assert(ids->size() == rows->size && rows->size >= 20000);
+        assert(extra_fields || rows->size == 20000);
+        for (size_t i = 0; i < rows->size; ++i)
+            assert((*ids)[0].integer[i] == (int64_t)rows->data[i].data[0] && (*ids)[1].integer[i] == (int64_t)rows->data[i].data[1]);
+
+        delete[] rows->data;
+        delete rows;
+        delete ids;
+        std::remove(path.c_str());
+        std::remove((path + ".lidx").c_str());
+    }
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: Shards werden in einen gemeinsamen Zielpuffer geparst, in Shard-Reihenfolge und mit den ID-Bereichen
+// der Shards; Leerzeilen (Lücken) und überzählige Felder (Überlauf) wie bei einer einzelnen Datei
+void test_sharded_parse()
+{
+    std::cout << "\n=== Testing Parser_mngr::parse_multithreaded over shards ===" << std::endl;
+
+    for (bool extra_fields : {false, true})
+    {
+        std::vector<std::string> paths;
+        for (size_t s = 0; s < 3; ++s)
+        {
+            paths.push_back("/tmp/dupdetec_parse_shard_" + std::to_string(s) + ".csv");
+            std::ofstream out(paths.back(), std::ios::binary);
+            out << "lid,rid\n";
+            for (size_t i = 0; i < 3000 * (s + 1); ++i)
+            {
+                out << s * 100000 + i << "," << i * 7;
+                if (extra_fields && i % 500 == 0)
+                    out << "," << i + 1;
+                out << (!extra_fields && i % 11 == 0 ? "\n\n" : "\n");
+            }
+        }
+
+        const size_t default_chunk_bytes = parse_min_chunk_bytes;
+        parse_min_chunk_bytes = 4096;
+        Parser_mngr parser_mngr;
+        File_set files(paths, false);
+        dataSet<tuple_t<2, uintptr_t>>* rows = parser_mngr.parse_multithreaded<tuple_t<2, uintptr_t>>(files, "%d,%d", 4);
+
+        // Referenz: jeder Shard einzeln geparst, hintereinander
+        size_t offset = 0;
+        for (size_t s = 0; s < 3; ++s)
+        {
+            File shard(paths[s], false);
+            dataSet<tuple_t<2, uintptr_t>>* expected = parser_mngr.parse_multithreaded<tuple_t<2, uintptr_t>>(shard, "%d,%d", 2);
+            assert(files.record_base(s) == offset);
+            assert(files.shard_of(offset) == s && expected->data[0].data[0] == s * 100000);
+            for (size_t i = 0; i < expected->size; ++i)
+                assert(rows->data[offset + i].data[0] == expected->data[i].data[0] && rows->data[offset + i].data[1] == expected->data[i].data[1]);
+            offset += expected->size;
+            delete[] expected->data;
+            delete expected;
+        }
+        parse_min_chunk_bytes = default_chunk_bytes;
+        assert(files.record_base(3) == rows->size && offset == rows->size);
+        assert(extra_fields ? rows->size > 18000 : rows->size == 18000);
+
+        delete[] rows->data;
+        delete rows;
+        for (const std::string& path : paths)
+            std::remove(path.c_str());
+    }
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: Wörterbuchkodierung nur für Textspalten mit wenigen Werten, jeder Code führt auf denselben Text
+void test_dictionary_encode()
+{
+    std::cout << "\n=== Testing Parser_mngr::dictionary_encode ===" << std::endl;
+
+    std::string path = "/tmp/dupdetec_dictionary.csv";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "id,name,price,brand,description,category\n";
+        for (size_t i = 0; i < 4000; ++i)
+            out << i << ",Titel " << i << "," << i % 50 << ".99,Brand" << i % 13 << ",,\"Kategorie, " << i % 3 << "\"\n";
+    }
+    const std::string format = "%_,%s,%f,%s,%s,%V";
+
+    Parser_mngr parser_mngr;
+    File file(path, false);
+    dataSet<quintupel>* rows = parser_mngr.parse_multithreaded<quintupel>(file, format, 3);
+    Dictionary_set* dictionaries = parser_mngr.dictionary_encode(rows, format, 3);
+
+    assert(dictionaries->size() == 4000 && dictionaries->slot_count() == 5);
+    assert((*dictionaries)[0] == nullptr); // jeder Titel kommt nur einmal vor
+    assert((*dictionaries)[1] == nullptr); // Preis ist kein Text
+    assert(dictionaries->encoded_count() == 3);
+    assert((*dictionaries)[2]->values.size() == 13 && (*dictionaries)[3]->values.size() == 1 && (*dictionaries)[4]->values.size() == 3);
+    for (size_t slot : {2, 3, 4})
+    {
+        const text_dictionary* dictionary = (*dictionaries)[slot];
+        size_t total = 0;
+        for (uint32_t count : dictionary->occurrences)
+            total += count;
+        assert(total == rows->size);
+        for (size_t i = 0; i < rows->size; ++i)
+            assert(strcmp(dictionary->values[dictionary->codes[i]], (const char*)rows->data[i].data[slot]) == 0);
+    }
+    assert(dictionaries->encode((const uintptr_t*)rows->data, 5, 0) == false);
+
+    bool rejected = false;
+    try { parser_mngr.dictionary_encode(rows, "%_,%s,%V", 3); } catch (const std::runtime_error&) { rejected = true; }
+    assert(rejected);
+
+    delete dictionaries;
+    delete[] rows->data;
+    delete rows;
+    std::remove(path.c_str());
+    std::remove((path + ".lidx").c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: dieselbe Storage-Datei als TSV und als JSONL (mit \" in den Texten, ohne Kopfzeile) ergibt dieselben
+// Zeilen wie CSV (Feldnamen wie in main.cpp, damit die eingebauten Parser greifen), auch wenn die Blockgrenzen der Threads in Texten liegen
+void test_dialect_files()
+{
+    std::cout << "\n=== Testing TSV and JSONL input ===" << std::endl;
+
+    std::string csv_path = "/tmp/dupdetec_dialect.csv", tsv_path = "/tmp/dupdetec_dialect.tsv", json_path = "/tmp/dupdetec_dialect.jsonl";
+    std::string csv = write_storage_csv(csv_path, 20000);
+    {
+        std::string tsv = csv;
+        for (char& c : tsv)
+            if (c == ',')
+                c = '\t';
+        std::ofstream out(tsv_path, std::ios::binary);
+        out << tsv;
+    }
+    {
+        std::ofstream out(json_path, std::ios::binary);
+        for (size_t i = 0; i < 20000; ++i)
+            out << "{\"category\": \"Titel " << std::string(i % 40, 'x') << "\", \"id\": " << i << ", \"name\": \"Brand" << i % 7
+                << "\", \"brand\": \"USB \\\"" << i % 4 << "\\\"\", \"description\": \"SD\"}\n";
+    }
+    const std::vector<std::string> keys = {"id", "name", "price", "brand", "description", "category"};
+    const std::string csv_format = "%_,%s,%*,%s,%s,%V";
+    const std::string tsv_format = dialect_format(csv_format, dialect_tsv, keys);
+    const std::string json_format = dialect_format(csv_format, dialect_jsonl, keys);
+    assert(input_dialect(tsv_path) == dialect_tsv && input_dialect(json_path) == dialect_jsonl);
+
+    Parser_mngr parser_mngr;
+    File csv_file(csv_path, false), tsv_file(tsv_path, false), json_file(json_path, true);
+    dataSet<quintupel>* expected = parser_mngr.parse_multithreaded<quintupel>(csv_file, csv_format, 4);
+    dataSet<quintupel>* tsv_rows = parser_mngr.parse_multithreaded<quintupel>(tsv_file, tsv_format, 4);
+    dataSet<quintupel>* json_rows = parser_mngr.parse_multithreaded<quintupel>(json_file, json_format, 4, header_lines(dialect_jsonl));
+    assert(expected->size == 20000 && tsv_rows->size == expected->size && json_rows->size == expected->size);
+    for (size_t i = 0; i < expected->size; ++i)
+    {
+        for (size_t c : {0, 2, 3, 4})
+        {
+            const char* text = (const char*)expected->data[i].data[c];
+            assert(strcmp((const char*)tsv_rows->data[i].data[c], text) == 0);
+            assert(strcmp((const char*)json_rows->data[i].data[c], text) == 0);
+        }
+    }
+
+    for (dataSet<quintupel>* rows : {expected, tsv_rows, json_rows})
+    {
+        delete[] rows->data;
+        delete rows;
+    }
+    for (const std::string& path : {csv_path, tsv_path, json_path})
+    {
+        std::remove(path.c_str());
+        std::remove((path + ".lidx").c_str());
+    }
+    std::cout << "Test passed!" << std::endl;
+}
+
+int main()
+{
+    std::cout << "Starting columnar parse tests...\n" << std::endl;
+
+    test_columns_match_rows();
+    test_id_columns();
+    test_columns_from_chunks();
+    test_sharded_parse();
+    test_dictionary_encode();
+    test_dialect_files();
+
+    std::cout << "\nAll tests completed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,506 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <cstdio>
+#include <future>
+#include "../../FileInput.h"
+#include "../../ThreadWorks.h"
+
+// Schreibt content in eine temporäre Datei und gibt den Pfad zurück
+std::string write_temp_file(const std::string& name, const std::string& content)
+{
+    std::string path = "/tmp/" + name;
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+    out.close();
+    return path;
+}
+
+// Naive Referenz: Offsets aller Zeilenanfänge
+std::vector<size_t> naive_line_starts(const std::string& content)
+{
+    std::vector<size_t> starts = {0};
+    for (size_t i = 0; i < content.size(); ++i)
+        if (content[i] == '\n' && i + 1 < content.size())
+            starts.push_back(i + 1);
+    return starts;
+}
+
+// Erzeugt unterschiedlich lange Zeilen "id,xxxx...\n", damit die Blockgrenzen ungleichmäßig liegen
+std::string make_uneven_csv(size_t rows)
+{
+    std::string content = "id,title\n";
+    for (size_t i = 0; i < rows; ++i)
+        content += std::to_string(i) + "," + std::string((i * 7919) % 300, 'a' + (i % 26)) + "\n";
+    return content;
+}
+
+// Test: Zeilenindex stimmt mit naiver Zählung überein (auch mit mehreren Threads und SIMD-Blockgrenzen)
+void test_line_index()
+{
+    std::cout << "=== Testing File::build_line_index ===" << std::endl;
+
+    std::string content = make_uneven_csv(20000);
+    std::string path = write_temp_file("dupdetec_line_index.csv", content);
+    std::vector<size_t> expected = naive_line_starts(content);
+
+    for (size_t threads : {1, 3, 8})
+    {
+        File file(path, true);
+        assert(file.count_lines() == expected.size() + 1); // abschließendes '\n' + \0 werden mitgezählt
+        file.build_line_index(threads);
+        assert(file.line_count() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            assert(file.line_index()[i] == expected[i]);
+        assert(file.line_index()[file.line_count()] == file.size());
+    }
+
+    std::remove(path.c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: threaded_line_split mit Zeilenindex liefert alle Zeilen in Reihenfolge, Puffer exakt groß
+void test_indexed_split()
+{
+    std::cout << "\n=== Testing threaded_line_split with line index ===" << std::endl;
+
+    std::string content = make_uneven_csv(5000);
+    std::string path = write_temp_file("dupdetec_indexed_split.csv", content);
+    File file(path, true);
+    file.build_line_index(4);
+
+    // Parser-Ersatz: merkt sich die führende Zahl der Zeile und liefert die Zeilenlänge ohne '\n'
+    std::function<int(const char*, void*)> parse_line = [](const char* line, void* out) {
+        *(uintptr_t*)out = (uintptr_t)strtol(line, nullptr, 10);
+        const char* p = line;
+        while (*p && *p != '\n') ++p;
+        return (int)(p - line);
+    };
+
+    const size_t num_threads = 4;
+    single_t* buffers[num_threads];
+    size_t counts[num_threads];
+    size_t first_line = 1;
+    threaded_line_split<single_t>(file.data(), "%d", file.size(), num_threads, file.line_index()[first_line], file.line_count() - first_line, parse_line, buffers, counts, file.line_index(), first_line);
+
+    size_t expected_id = 0;
+    for (size_t t = 0; t < num_threads; ++t)
+    {
+        for (size_t i = 0; i < counts[t]; ++i)
+            assert(buffers[t][i].data[0] == expected_id++);
+        delete[] buffers[t];
+    }
+    assert(expected_id == 5000);
+
+    std::remove(path.c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Erzeugt Datensätze mit langen Titeln in Anführungszeichen, die Zeilenumbrüche, Kommas und "" enthalten
+std::string make_multiline_csv(size_t rows, std::vector<size_t>& record_starts)
+{
+    std::string content = "id,title\n";
+    record_starts = {0};
+    for (size_t i = 0; i < rows; ++i)
+    {
+        record_starts.push_back(content.size());
+        content += std::to_string(i) + ",";
+        if (i % 3 == 0)
+        {
+            content += "\"";
+            for (size_t k = 0; k < (i * 31) % 40 + 1; ++k)
+                content += (k % 5 == 4) ? "\"\"zitat\"\",\n" : "zeile mit\numbruch ";
+            content += "\"";
+        }
+        else
+            content += std::string((i * 7919) % 120, 'a' + (i % 26));
+        content += "\n";
+    }
+    return content;
+}
+
+// Test: Zeilenumbrüche in Anführungszeichen beginnen keinen Datensatz, weder im Index noch bei der
+// Aufteilung ohne Index (Blockgrenzen liegen hier fast immer mitten in einem Titel)
+void test_quoted_record_split()
+{
+    std::cout << "\n=== Testing quote-aware record split ===" << std::endl;
+
+    std::vector<size_t> expected;
+    std::string content = make_multiline_csv(6000, expected);
+    std::string path = write_temp_file("dupdetec_multiline.csv", content);
+
+    for (size_t threads : {1, 3, 8})
+    {
+        File file(path, true);
+        file.build_line_index(threads);
+        assert(file.line_count() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            assert(file.line_index()[i] == expected[i]);
+    }
+
+    // Parser-Ersatz: führende Zahl merken, Titel samt Anführungszeichen überspringen
+    std::function<int(const char*, void*)> parse_line = [](const char* line, void* out) {
+        char* p;
+        *(uintptr_t*)out = (uintptr_t)strtol(line, &p, 10);
+        if (*p == ',') ++p;
+        return (int)(simd_skip_field(p) - line);
+    };
+
+    File file(path, true);
+    for (size_t num_threads : {2, 5, 16})
+    {
+        std::vector<single_t*> buffers(num_threads);
+        std::vector<size_t> counts(num_threads);
+        threaded_line_split<single_t>(file.data(), "%d", file.size(), num_threads, expected[1], file.count_lines(), parse_line, buffers.data(), counts.data());
+
+        size_t expected_id = 0;
+        for (size_t t = 0; t < num_threads; ++t)
+        {
+            for (size_t i = 0; i < counts[t]; ++i)
+                assert(buffers[t][i].data[0] == expected_id++);
+            delete[] buffers[t];
+        }
+        assert(expected_id == 6000);
+    }
+
+    std::remove(path.c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: threaded_line_fill schreibt direkt in einen Zielpuffer, mit und ohne Zeilenindex; Leerzeilen
+// (weniger Datensätze als gezählt) und Zeilen mit überzähligen Feldern (mehr als gezählt) bleiben korrekt.
+// Mit kleinen Blöcken (parse_min_chunk_bytes) holt sich jeder Thread mehrere Blöcke, die Reihenfolge bleibt gleich.
+void test_line_fill()
+{
+    std::cout << "\n=== Testing threaded_line_fill ===" << std::endl;
+
+    // Parser-Ersatz wie der echte Parser: führende Zahl merken, Felder bis zum Zeilenende bzw. bis zum
+    // ersten überzähligen ',' überspringen, anschließende Zeilenumbrüche mit verbrauchen
+    std::function<int(const char*, void*)> parse_line = [](const char* line, void* out) {
+        char* p;
+        *(uintptr_t*)out = (uintptr_t)strtol(line, &p, 10);
+        if (*p == ',') ++p;
+        const char* end = simd_skip_field(p);
+        while (*end == '\n') ++end;
+        return (int)(end - line);
+    };
+
+    std::vector<size_t> starts;
+    std::string multiline = make_multiline_csv(6000, starts);
+    std::string blank_lines = "id,title\n";
+    for (size_t i = 0; i < 3000; ++i)
+        blank_lines += std::to_string(i) + ",x\n" + (i % 7 == 0 ? "\n\n" : "");
+
+    std::vector<std::pair<std::string, size_t>> cases = {{multiline, 6000}, {blank_lines, 3000}};
+    const size_t default_chunk_bytes = parse_min_chunk_bytes;
+    for (const auto& [content, rows] : cases)
+    {
+        std::string path = write_temp_file("dupdetec_line_fill.csv", content);
+        File file(path, true);
+        file.build_line_index(3);
+        for (size_t chunk_bytes : {default_chunk_bytes, (size_t)1024})
+        {
+            parse_min_chunk_bytes = chunk_bytes;
+            for (size_t num_threads : {1, 2, 5, 16})
+            {
+                if (chunk_bytes < default_chunk_bytes && num_threads <= 5)
+                    assert(parse_chunk_count(file.size(), num_threads) >= 4 * num_threads);
+                for (bool indexed : {true, false})
+                {
+                    size_t count = 0;
+                    single_t* rows_out = indexed
+                        ? threaded_line_fill<single_t>(file.data(), file.size(), num_threads, file.line_index()[1], file.line_count() - 1, parse_line, count, file.line_index(), 1)
+                        : threaded_line_fill<single_t>(file.data(), file.size(), num_threads, file.line_index()[1], file.count_lines(), parse_line, count);
+                    assert(count == rows);
+                    for (size_t i = 0; i < count; ++i)
+                        assert(rows_out[i].data[0] == i);
+                    delete[] rows_out;
+                }
+            }
+        }
+        parse_min_chunk_bytes = default_chunk_bytes;
+        std::remove(path.c_str());
+    }
+
+    // Überzählige Felder: "5,x,y" liefert zwei Datensätze (5 und 0), mehr als Zeilen gezählt wurden
+    std::string extra = "id,title\n";
+    for (size_t i = 1; i <= 1000; ++i)
+        extra += std::to_string(i) + (i % 10 == 0 ? ",x,y\n" : ",x\n");
+    std::string path = write_temp_file("dupdetec_line_fill.csv", extra);
+    File file(path, true);
+    size_t count = 0;
+    single_t* rows_out = threaded_line_fill<single_t>(file.data(), file.size(), 4, 9, file.count_lines(), parse_line, count);
+    assert(count == 1100);
+    for (size_t i = 0, id = 1; i < count; ++i)
+    {
+        assert(rows_out[i].data[0] == id);
+        if (id % 10 == 0)
+            assert(rows_out[++i].data[0] == 0);
+        ++id;
+    }
+    delete[] rows_out;
+    std::remove(path.c_str());
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: .lidx-Datei wird geschrieben, beim nächsten Öffnen gemappt und nach einer Änderung verworfen
+void test_line_index_file()
+{
+    std::cout << "\n=== Testing .lidx line index file ===" << std::endl;
+
+    std::string content = make_uneven_csv(3000);
+    std::string path = write_temp_file("dupdetec_sidecar.csv", content);
+    std::remove((path + ".lidx").c_str());
+    std::vector<size_t> expected = naive_line_starts(content);
+
+    {
+        File file(path, false, true); // baut und schreibt den Index
+        assert(file.line_count() == expected.size());
+    }
+    {
+        File file(path, false, true); // mappt den Index
+        assert(file.line_count() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            assert(file.line_index()[i] == expected[i]);
+    }
+
+    // Datei ändern -> Index ist veraltet und wird neu aufgebaut
+    content += "3000,neu\n";
+    write_temp_file("dupdetec_sidecar.csv", content);
+    {
+        File file(path, false, true);
+        assert(file.line_count() == expected.size() + 1);
+        assert(file.line_index()[file.line_count() - 1] == content.size() - 9);
+    }
+
+    std::remove((path + ".lidx").c_str());
+    std::remove(path.c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: File_stream liefert Blöcke, die auf Datensatzenden liegen (auch bei Zeilenumbrüchen in Anführungszeichen)
+void test_file_stream()
+{
+    std::cout << "\n=== Testing File_stream blocks ===" << std::endl;
+
+    std::string content = "id,title\n";
+    for (size_t i = 0; i < 4000; ++i)
+    {
+        if (i % 7 == 0)
+            content += std::to_string(i) + ",\"zeile mit\numbruch und \"\"zitat\"\"\"\n";
+        else
+            content += std::to_string(i) + "," + std::string(i % 200, 'x') + "\n";
+    }
+    content += "4000," + std::string(10000, 'y') + "\n"; // größer als das Fenster
+    std::string path = write_temp_file("dupdetec_stream.csv", content);
+
+    File_stream stream(path, 4096);
+    std::string joined;
+    size_t block_size = 0;
+    size_t blocks = 0;
+    while (char* block = stream.next_block(block_size))
+    {
+        assert(block[block_size] == '\0');
+        assert(block_size == content.size() - joined.size() || block[block_size - 1] == '\n');
+        // Block muss vor einem Datensatz enden: nächster Datensatz beginnt mit seiner ID
+        if (joined.size() + block_size < content.size())
+            assert(isdigit((unsigned char)content[joined.size() + block_size]));
+        joined.append(block, block_size);
+        ++blocks;
+    }
+    assert(joined == content);
+    assert(blocks > 10);
+
+    std::remove(path.c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: File_stream über eine Pipe (Lese-Thread, Doppelpuffer), Erzeuger schreibt stückweise
+void test_pipe_stream()
+{
+    std::cout << "\n=== Testing File_stream on a pipe ===" << std::endl;
+
+    std::string content = "id,title\n";
+    for (size_t i = 0; i < 3000; ++i)
+    {
+        if (i % 11 == 0)
+            content += std::to_string(i) + ",\"mit\numbruch\"\n";
+        else
+            content += std::to_string(i) + "," + std::string(i % 150, 'p') + "\n";
+    }
+    content += "3000," + std::string(20000, 'q') + "\n"; // größer als beide Puffer
+
+    int fds[2];
+    assert(pipe(fds) == 0);
+    std::thread producer([&]() {
+        // ungerade Stückgrößen, damit Lesegrenzen mitten in Datensätzen liegen
+        for (size_t pos = 0; pos < content.size();)
+        {
+            size_t chunk = std::min<size_t>(777, content.size() - pos);
+            assert(write(fds[1], content.data() + pos, chunk) == (ssize_t)chunk);
+            pos += chunk;
+        }
+        close(fds[1]);
+    });
+
+    std::string joined;
+    {
+        File_stream stream("/dev/fd/" + std::to_string(fds[0]), 4096);
+        size_t block_size = 0;
+        while (char* block = stream.next_block(block_size))
+        {
+            assert(block[block_size] == '\0');
+            if (joined.size() + block_size < content.size())
+                assert(isdigit((unsigned char)content[joined.size() + block_size]));
+            joined.append(block, block_size);
+        }
+        assert(stream.size() == content.size());
+    }
+    producer.join();
+    close(fds[0]);
+    assert(joined == content);
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: bricht der Verbraucher ab, während der Erzeuger die Pipe offen hält (ohne zu schreiben), kehrt der
+// Destruktor trotzdem zurück, statt auf den blockierten Lese-Thread zu warten
+void test_pipe_stream_early_stop()
+{
+    std::cout << "\n=== Testing File_stream destructor with an idle pipe ===" << std::endl;
+
+    int fds[2];
+    assert(pipe(fds) == 0);
+    std::string partial = "id,title\n1,unvollst";
+    assert(write(fds[1], partial.data(), partial.size()) == (ssize_t)partial.size());
+
+    auto stream = std::make_unique<File_stream>("/dev/fd/" + std::to_string(fds[0]), 4096);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Lese-Thread wartet jetzt auf weitere Daten
+    std::future<void> destroyed = std::async(std::launch::async, [&]() { stream.reset(); });
+    assert(destroyed.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+
+    close(fds[1]);
+    close(fds[0]);
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: File_set expandiert Muster und Listen sortiert und ordnet globale IDs den Shards zu
+void test_file_set()
+{
+    std::cout << "\n=== Testing File_set ===" << std::endl;
+
+    std::vector<std::string> paths;
+    for (int i = 2; i >= 0; --i)
+        paths.insert(paths.begin(), write_temp_file("dupdetec_shard_" + std::to_string(i) + ".csv", make_uneven_csv(100 * (i + 1))));
+
+    File_set set("/tmp/dupdetec_shard_*.csv", false);
+    assert(set.shard_count() == 3);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        assert(set.shard(i).size() == make_uneven_csv(100 * (i + 1)).size());
+        set.shard(i).build_line_index(2);
+        assert(set.shard(i).line_count() == 100 * (i + 1) + 1);
+    }
+
+    File_set list(paths[2] + "," + paths[0], false); // Listenreihenfolge bleibt erhalten
+    assert(list.shard_count() == 2);
+    assert(list.shard(0).size() == set.shard(2).size());
+
+    set.set_record_bases({0, 100, 300, 600});
+    assert(set.shard_of(0) == 0);
+    assert(set.shard_of(99) == 0);
+    assert(set.shard_of(100) == 1);
+    assert(set.shard_of(599) == 2);
+
+    for (const std::string& path : paths)
+        std::remove(path.c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: wirft der Konstruktor, während der io_uring-Lese-Thread noch läuft (hier ungültige gzip-Daten),
+// kommt die Ausnahme beim Aufrufer an, statt über einen nicht gejointen Thread std::terminate auszulösen
+void test_uring_constructor_error()
+{
+    std::cout << "\n=== Testing File constructor error with io_uring ===" << std::endl;
+
+    std::string content = "\x1f\x8b\x08";
+    content += std::string(4 << 20, 'x');
+    std::string path = write_temp_file("dupdetec_broken.csv.gz", content);
+
+    File_config config;
+    config.backend = read_uring;
+    config.read_block = 4096;
+    bool thrown = false;
+    try { File file(path, true, false, config); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+
+    std::remove(path.c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+#ifdef WITH_ZLIB
+// Hängt content als eigenes gzip-Member an out an
+void append_gzip_member(std::string& out, const std::string& content)
+{
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    assert(deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+    std::vector<char> member(deflateBound(&zs, content.size()) + 32);
+    zs.next_in = (Bytef*)content.data();
+    zs.avail_in = content.size();
+    zs.next_out = (Bytef*)member.data();
+    zs.avail_out = member.size();
+    assert(deflate(&zs, Z_FINISH) == Z_STREAM_END);
+    out.append(member.data(), zs.total_out);
+    deflateEnd(&zs);
+}
+
+// Test: mehrteilige gzip-Datei wird entpackt und wie die unkomprimierte Datei indiziert
+void test_gzip_input()
+{
+    std::cout << "\n=== Testing gzip input ===" << std::endl;
+
+    std::string content = make_uneven_csv(6000);
+    std::string compressed;
+    for (size_t start = 0; start < content.size(); start += 50000)
+        append_gzip_member(compressed, content.substr(start, 50000)); // Member enden mitten in Zeilen
+    std::string path = write_temp_file("dupdetec_input.csv.gz", compressed);
+    std::vector<size_t> expected = naive_line_starts(content);
+
+    File file(path, true);
+    assert(file.size() == content.size());
+    assert(std::string(file.data(), file.size()) == content);
+    file.build_line_index(4);
+    assert(file.line_count() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        assert(file.line_index()[i] == expected[i]);
+
+    std::remove(path.c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+#endif
+
+int main()
+{
+    std::cout << "Starting File input tests...\n" << std::endl;
+
+    test_line_index();
+    test_indexed_split();
+    test_quoted_record_split();
+    test_line_fill();
+    test_line_index_file();
+    test_file_stream();
+    test_pipe_stream();
+    test_pipe_stream_early_stop();
+    test_file_set();
+    test_uring_constructor_error();
+#ifdef WITH_ZLIB
+    test_gzip_input();
+#endif
+
+    std::cout << "\nAll tests completed successfully!" << std::endl;
+    return 0;
+}
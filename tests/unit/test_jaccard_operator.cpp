@@ -54,10 +54,12 @@ int main()
     char parsed_line3[1024] = {0};
     char parsed_line4[1024] = {0};
 
-    parser(lines[0].c_str(), parsed_line1);
-    parser(lines[1].c_str(), parsed_line2);
-    parser(lines[2].c_str(), parsed_line3);
-    parser(lines[3].c_str(), parsed_line4);
+    char text[4096];
+    char* text_cursor = text;
+    parser(lines[0].c_str(), parsed_line1, &text_cursor);
+    parser(lines[1].c_str(), parsed_line2, &text_cursor);
+    parser(lines[2].c_str(), parsed_line3, &text_cursor);
+    parser(lines[3].c_str(), parsed_line4, &text_cursor);
 
     laptop1.descriptor = parsed_line1;
     laptop2.descriptor = parsed_line2;
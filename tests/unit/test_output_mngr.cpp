@@ -0,0 +1,190 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <cstdio>
+#include <algorithm>
+#include "../../Output_mngr.h"
+
+// Erzeugt partitions Partitionen mit unterschiedlich vielen Matches (auch leere)
+dataSet<matching>* make_matches(size_t partitions)
+{
+    dataSet<matching>* matches = new dataSet<matching>();
+    matches->size = partitions;
+    matches->data = new matching[partitions];
+    for (size_t p = 0; p < partitions; ++p)
+    {
+        size_t count = (p % 5 == 3) ? 0 : (p * 37) % 900 + 1;
+        matches->data[p].size = count;
+        matches->data[p].matches = new match[count];
+        for (size_t i = 0; i < count; ++i)
+        {
+            matches->data[p].matches[i].data[0] = p * 100000 + i;
+            matches->data[p].matches[i].data[1] = (p * 7919 + i * 31) % 1000003;
+            matches->data[p].matches[i].jaccard_index = (double)(i % 97) / 97.0;
+        }
+    }
+    return matches;
+}
+
+void free_matches(dataSet<matching>* matches)
+{
+    for (size_t p = 0; p < matches->size; ++p)
+        delete[] matches->data[p].matches;
+    delete[] matches->data;
+    delete matches;
+}
+
+std::string read_file(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+// Test: CSV ist unabhängig von der Threadzahl identisch, Reihenfolge wie in den Partitionen, Scores exakt
+void test_csv_output()
+{
+    std::cout << "=== Testing Output_mngr CSV ===" << std::endl;
+
+    dataSet<matching>* matches = make_matches(120);
+    std::string path = "/tmp/dupdetec_matches.csv";
+
+    Output_mngr::write_matches(path, matches, Output_mngr::output_csv, 1);
+    std::string single = read_file(path);
+    Output_mngr::write_matches(path, matches, Output_mngr::output_csv, 8);
+    std::string threaded = read_file(path);
+    assert(single == threaded);
+
+    std::istringstream lines(threaded);
+    std::string line;
+    std::getline(lines, line);
+    assert(line == "lid,rid,score");
+    for (size_t p = 0; p < matches->size; ++p)
+    {
+        for (size_t i = 0; i < matches->data[p].size; ++i)
+        {
+            const match& m = matches->data[p].matches[i];
+            unsigned long long lid, rid;
+            double score;
+            assert(std::getline(lines, line));
+            assert(sscanf(line.c_str(), "%llu,%llu,%lf", &lid, &rid, &score) == 3);
+            assert(lid == m.data[0] && rid == m.data[1]);
+            assert(score == m.jaccard_index); // kürzeste Darstellung ist verlustfrei
+        }
+    }
+    assert(!std::getline(lines, line));
+
+    std::remove(path.c_str());
+    free_matches(matches);
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: Binärformat ist sortiert, eindeutig (höchster Score gewinnt) und über Result_file direkt nutzbar
+void test_binary_output()
+{
+    std::cout << "\n=== Testing Output_mngr binary result file ===" << std::endl;
+
+    dataSet<matching>* matches = make_matches(60);
+    // dasselbe Paar in zwei Partitionen und umgekehrter Reihenfolge
+    matches->data[1].matches[0] = {{42, 17}, 0.25};
+    matches->data[2].matches[0] = {{17, 42}, 0.75};
+    std::string path = "/tmp/dupdetec_matches.bin";
+    assert(Output_mngr::format_from_path(path) == Output_mngr::output_binary);
+
+    std::vector<match_record> expected;
+    for (size_t p = 0; p < matches->size; ++p)
+        for (size_t i = 0; i < matches->data[p].size; ++i)
+        {
+            const match& m = matches->data[p].matches[i];
+            expected.push_back({std::min<uint64_t>(m.data[0], m.data[1]), std::max<uint64_t>(m.data[0], m.data[1]), m.jaccard_index});
+        }
+    std::sort(expected.begin(), expected.end(), [](const match_record& l, const match_record& r) {
+        return l.id_a != r.id_a ? l.id_a < r.id_a : l.id_b < r.id_b;
+    });
+
+    Output_mngr::write_matches(path, matches, Output_mngr::output_binary, 4);
+    {
+        Result_file result(path);
+        assert(!result.has_clusters());
+        assert(result.match_count() < expected.size()); // Duplikate zusammengefasst
+        for (size_t i = 1; i < result.match_count(); ++i)
+        {
+            const match_record& l = result.matches()[i - 1];
+            const match_record& r = result.matches()[i];
+            assert(l.id_a < r.id_a || (l.id_a == r.id_a && l.id_b < r.id_b));
+        }
+        for (const match_record& e : expected)
+        {
+            const match_record* found = result.find(e.id_b, e.id_a);
+            assert(found && found->score >= e.score);
+        }
+        assert(result.find(17, 42)->score == 0.75);
+        assert(result.find(1, 2) == nullptr);
+    }
+
+    std::remove(path.c_str());
+    free_matches(matches);
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: Cluster sind die Zusammenhangskomponenten der Matches
+void test_cluster_tables()
+{
+    std::cout << "\n=== Testing Output_mngr cluster tables ===" << std::endl;
+
+    // {1, 2, 3, 9} über eine Kette, {5, 7} allein, 10-11 in einer zweiten Partition
+    dataSet<matching> matches;
+    matching parts[2];
+    match first[] = {{{3, 1}, 0.9}, {{5, 7}, 0.8}, {{2, 3}, 0.85}, {{9, 2}, 0.7}};
+    match second[] = {{{11, 10}, 0.95}, {{1, 3}, 0.5}};
+    parts[0] = {first, 4};
+    parts[1] = {second, 2};
+    matches.data = parts;
+    matches.size = 2;
+
+    std::string path = "/tmp/dupdetec_clusters.bin";
+    Output_mngr::write_matches(path, &matches, Output_mngr::output_binary, 2, true);
+    {
+        Result_file result(path);
+        assert(result.has_clusters());
+        assert(result.match_count() == 5);
+        assert(result.cluster_count() == 3);
+
+        std::vector<std::vector<uint64_t>> expected = {{1, 2, 3, 9}, {5, 7}, {10, 11}};
+        for (size_t c = 0; c < 3; ++c)
+        {
+            size_t size = 0;
+            const uint64_t* ids = result.cluster(c, size);
+            assert(std::vector<uint64_t>(ids, ids + size) == expected[c]);
+        }
+    }
+
+    // kaputte Dateien werden abgelehnt
+    FILE* out = fopen(path.c_str(), "r+b");
+    fseek(out, 8, SEEK_SET);
+    uint32_t version = 99;
+    fwrite(&version, sizeof(version), 1, out);
+    fclose(out);
+    bool rejected = false;
+    try { Result_file broken(path); } catch (const std::runtime_error&) { rejected = true; }
+    assert(rejected);
+
+    std::remove(path.c_str());
+    std::cout << "Test passed!" << std::endl;
+}
+
+int main()
+{
+    std::cout << "Starting Output_mngr tests...\n" << std::endl;
+
+    test_csv_output();
+    test_binary_output();
+    test_cluster_tables();
+
+    std::cout << "\nAll tests completed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,456 @@
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cstring>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "../../static_parser.h"
+
+// Test: Feldtypen und Slots werden zur Build-Zeit aus dem Format-Literal bestimmt
+void test_format_expansion()
+{
+    std::cout << "=== Testing static_parser format expansion ===" << std::endl;
+
+    static_assert(format_field_count<"%_,%s,%f,%s,%s,%V">() == 6);
+    static_assert(format_fields<"%_,%s,%f,%s,%s,%V">()[2] == 'f');
+    static_assert(format_slot<"%_,%s,%f,%s,%s,%V">(0) == 0);
+    static_assert(format_slot<"%_,%s,%f,%s,%s,%V">(5) == 4); // %_ belegt keinen Slot
+    static_assert(format_field_count<"%d,%d">() == 2);
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: eingebauter Parser liefert Zahlen, normalisierte Texte im Arena-Bereich und die Zeilenlänge
+void test_builtin_parsers()
+{
+    std::cout << "\n=== Testing builtin parsers ===" << std::endl;
+
+    char text[256];
+    char* cursor = text;
+    uintptr_t fields[5] = {0};
+
+    const char* storage = "17,Sandisk,12.5,\"USB \"\"3.0\"\"\",SD,Extreme Pro 64GB\n18,x";
+    size_t length = static_parser<"%_,%s,%f,%s,%s,%V">(storage, fields, &cursor);
+    assert(storage[length] == '1' && storage[length + 1] == '8'); // hinter dem Zeilenende
+    double price;
+    memcpy(&price, &fields[1], sizeof(price));
+    assert(price == 12.5);
+    const char* brand = (const char*)fields[0];
+    const char* interface = (const char*)fields[2];
+    const char* rest = (const char*)fields[4];
+    assert(brand >= text && rest < cursor);
+    assert(text_length(brand) == 7 && brand[0] == 's' && brand[6] == 'k');
+    assert(text_length(interface) == 9); // jedes "" wird zu einem Escape-Zeichen
+    assert(interface[4] == (char)Escape);
+    assert(text_length(rest) == 16);
+    assert(strlen(storage) == strlen("17,Sandisk,12.5,\"USB \"\"3.0\"\"\",SD,Extreme Pro 64GB\n18,x")); // Eingabe unverändert
+
+    bool found = false;
+    for (const builtin_parser& builtin : builtin_parsers())
+    {
+        if (builtin.format == "%d,%d")
+        {
+            found = true;
+            uintptr_t ids[2];
+            builtin.parse("4730,5026\r\n", ids, &cursor);
+            assert(ids[0] == 4730 && ids[1] == 5026);
+        }
+    }
+    assert(found);
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: project_format ersetzt nicht gelesene Felder durch %*, der projizierte Parser überspringt sie
+// (auch in Anführungszeichen mit Komma und Zeilenumbruch), alle übrigen Slots bleiben gleich
+void test_projection()
+{
+    std::cout << "\n=== Testing column projection ===" << std::endl;
+
+    const std::string format = "%_,%s,%f,%s,%s,%V";
+    std::string projected = project_format(format, string_fields(format.c_str()));
+    assert(projected == "%_,%s,%*,%s,%s,%V");
+    assert(project_format("%d,%d", {1}) == "%*,%d");
+    assert(count_fields(projected.c_str()) == 5 && string_fields(projected.c_str()) == string_fields(format.c_str()));
+
+    const char* line = "17,Sandisk,12.5,USB,SD,Extreme Pro\n";
+    char full_text[256], projected_text[256];
+    char* full_cursor = full_text;
+    char* projected_cursor = projected_text;
+    uintptr_t full[5] = {0}, skipped[5] = {1, 1, 1, 1, 1};
+    size_t full_length = static_parser<"%_,%s,%f,%s,%s,%V">(line, full, &full_cursor);
+    size_t projected_length = static_parser<"%_,%s,%*,%s,%s,%V">(line, skipped, &projected_cursor);
+    assert(full_length == projected_length);
+    assert(skipped[1] == 0);
+    for (int slot : {0, 2, 3, 4})
+    {
+        text_view a = field_text(full[slot]), b = field_text(skipped[slot]);
+        assert(a.length == b.length && memcmp(a.data, b.data, a.length) == 0);
+    }
+
+    // Übersprungene Spalte in Anführungszeichen mit Komma und Zeilenumbruch
+    const char* quoted = "17,Sandisk,\"12,5\n\"\"x\"\"\",USB,SD,Extreme Pro\n";
+    projected_cursor = projected_text;
+    assert(static_parser<"%_,%s,%*,%s,%s,%V">(quoted, skipped, &projected_cursor) == strlen(quoted));
+    assert(field_text(skipped[2]).length == 3 && skipped[1] == 0);
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Byteweise Referenz für simd_skip_field (früherer parse_field_ignore)
+const char* naive_skip_field(const char* p)
+{
+    if (*p == '"')
+    {
+        ++p;
+        while (*p)
+        {
+            if (*p == '"')
+            {
+                if (*(p + 1) == '"')
+                    p += 2;
+                else
+                {
+                    ++p;
+                    break;
+                }
+            }
+            else
+                ++p;
+        }
+    }
+    while (*p && *p != ',' && *p != '\n' && *p != '\r') ++p;
+    return p;
+}
+
+// Test: SIMD-Scanner finden dieselben Feldgrenzen wie der byteweise Ablauf, auch über 64-Byte-Blöcke hinweg
+void test_simd_field_scan()
+{
+    std::cout << "\n=== Testing SIMD structural field scan ===" << std::endl;
+
+    const char* pieces[] = {"abc", "\"q\"\"x\"\"\"", ",", "\n", "\r\n", "\"a,b\nc\"", "\"\"", "  ", "\"offen", "x\"y"};
+    unsigned seed = 12345;
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::string line;
+        while (line.size() < (size_t)(round % 300))
+        {
+            seed = seed * 1103515245 + 12345;
+            line += pieces[(seed >> 16) % 10];
+        }
+        std::vector<char> buffer(line.size() + 128, '\0');
+        size_t shift = round % 64; // alle Ausrichtungen relativ zu den 64-Byte-Blöcken
+        memcpy(buffer.data() + shift, line.data(), line.size());
+        const char* begin = buffer.data() + shift;
+
+        for (const char* p = begin; *p;)
+        {
+            const char* expected = naive_skip_field(p);
+            assert(simd_skip_field(p) == expected);
+
+            char simd_text[512];
+            char* cursor = simd_text;
+            const char* end = copy_clean_csv(p, cursor);
+            assert(end == expected);
+            uint32_t length = text_length(simd_text + text_prefix); // Längenpräfix vor dem Text
+            assert(strlen(simd_text + text_prefix) == length);
+            assert(cursor - simd_text == (ptrdiff_t)(text_prefix + length + 1));
+
+            p = *expected ? expected + 1 : expected;
+        }
+    }
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: die Scanner lesen weder vor p noch über die Seite des Terminators hinaus. Der Text endet direkt vor einer
+// gesperrten Seite, die Anfänge liegen in den letzten Bytes der Seite davor (Kopie statt ungeausgerichtetem Laden)
+// und am Seitenanfang
+void test_simd_scan_bounds()
+{
+    std::cout << "\n=== Testing SIMD scan bounds ===" << std::endl;
+
+    const size_t page = sysconf(_SC_PAGESIZE);
+    char* pages = (char*)mmap(nullptr, 3 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(pages != MAP_FAILED);
+    assert(mprotect(pages, page, PROT_NONE) == 0 && mprotect(pages + 2 * page, page, PROT_NONE) == 0);
+    char* data = pages + page;
+
+    const char* pieces[] = {"ab", "\"q\"\"x\"", ",", "\n", "\\", "\"a,b\nc\""};
+    unsigned seed = 4711;
+    for (size_t length = 1; length < 200; ++length)
+    {
+        for (char* begin : {data, data + page - length})
+        {
+            std::string text;
+            while (text.size() < length - 1)
+            {
+                seed = seed * 1103515245 + 12345;
+                text += pieces[(seed >> 16) % 6];
+            }
+            text.resize(length - 1);
+            memcpy(begin, text.c_str(), length); // mit '\0'
+
+            for (const char* p = begin; *p; ++p)
+            {
+                assert(simd_skip_field(p) == naive_skip_field(p));
+                assert(simd_find_delimiter(p) == p + strcspn(p, ",\n\r"));
+                assert(simd_find_quote(p) == p + strcspn(p, "\""));
+                assert(simd_find_json_special(p) == p + strcspn(p, "\"\\\n"));
+                assert(simd_find_line_end(p) == p + strcspn(p, "\n"));
+            }
+        }
+    }
+
+    munmap(pages, 3 * page);
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: simd_normalize liefert für alle 256 Bytewerte, alle Längen und Ausrichtungen dasselbe wie lut,
+// auch in-place und in-place mit Verdichtung (dst < src). Mit -mavx2 bzw. -mssse3 übersetzt prüft derselbe Test
+// die pshufb-Varianten.
+void test_simd_normalize()
+{
+    std::cout << "\n=== Testing SIMD normalization kernel ===" << std::endl;
+
+    unsigned char input[256 + 80];
+    for (size_t i = 0; i < sizeof(input); ++i)
+        input[i] = (unsigned char)(i * 37 + 11); // enthält jeden Bytewert
+    for (size_t shift = 0; shift < 32; ++shift)
+    {
+        for (size_t n : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 100, 256})
+        {
+            const char* src = (const char*)input + shift;
+            char out[256 + 80];
+            simd_normalize(src, out, n);
+            for (size_t i = 0; i < n; ++i)
+                assert((unsigned char)out[i] == lut[(unsigned char)src[i]]);
+
+            char in_place[256 + 80];
+            memcpy(in_place, input, sizeof(input));
+            simd_normalize(in_place + shift, in_place + shift / 2, n); // dst <= src
+            for (size_t i = 0; i < n; ++i)
+                assert((unsigned char)in_place[shift / 2 + i] == lut[(unsigned char)src[i]]);
+        }
+    }
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Byteweise Referenz für simd_normalize_utf8: jede Sequenz einzeln dekodieren
+std::string naive_normalize_utf8(const std::string& in)
+{
+    std::string out;
+    for (size_t i = 0; i < in.size();)
+    {
+        unsigned char c = in[i];
+        if (c < 0x80)
+        {
+            out += (char)lut[c];
+            ++i;
+            continue;
+        }
+        char buffer[2];
+        size_t written = transliterate_utf8(in.data(), in.size(), i, buffer);
+        out.append(buffer, written);
+    }
+    return out;
+}
+
+std::string normalize_utf8(const std::string& in)
+{
+    std::string out(in.size(), '\0');
+    out.resize(simd_normalize_utf8(in.data(), out.data(), in.size()));
+    return out;
+}
+
+// Test: UTF-8-Normalisierung transliteriert Umlaute und Akzente, Symbole werden zu whitespace, ungültige Bytes
+// kosten kein Zeichen der Umgebung; Vektor- und Skalarpfad liefern dasselbe, auch in-place
+void test_utf8_normalize()
+{
+    std::cout << "\n=== Testing UTF-8 normalization ===" << std::endl;
+
+    std::string ws(1, (char)whitespace);
+    assert(normalize_utf8("Qualität") == "qualitaet");
+    assert(normalize_utf8("Straße") == "strasse");
+    assert(normalize_utf8("CAFÉ Łódź") == "cafe" + ws + "lodz");
+    assert(normalize_utf8("Speicher–Karte") == "speicher" + ws + "karte"); // Gedankenstrich (3 Bytes)
+    assert(normalize_utf8("Extreme®") == "extreme" + ws);
+    assert(normalize_utf8("a\xC3") == "a" + ws);               // abgeschnittene Sequenz
+    assert(normalize_utf8("a\xE4" "b") == "a" + ws + "b");   // Latin-1 statt UTF-8
+    assert(normalize_utf8("\xF0\x9F\x98\x80x") == ws + "x");  // 4-Byte-Sequenz (Emoji)
+
+    const char* pieces[] = {"Qualität ", "SanDisk", "ß", "–", "®", "\xC3", "\xFF", "Ünïcödé", "0123.456", "abcdefghijklmnopqrstuvwxyz"};
+    unsigned seed = 99;
+    for (int round = 0; round < 3000; ++round)
+    {
+        std::string text;
+        while (text.size() < (size_t)(round % 200))
+        {
+            seed = seed * 1103515245 + 12345;
+            text += pieces[(seed >> 16) % 10];
+        }
+        std::string expected = naive_normalize_utf8(text);
+        assert(expected.size() <= text.size());
+        assert(normalize_utf8(text) == expected);
+
+        std::string in_place = text;
+        in_place.resize(simd_normalize_utf8(in_place.data(), in_place.data(), in_place.size()));
+        assert(in_place == expected);
+    }
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: parse_double/parse_long liefern bitgenau dasselbe Ergebnis und Ende wie strtod/strtol, auch direkt
+// vor einem Seitenende (dort wird nicht in 8-Byte-Blöcken gelesen)
+void test_number_parsing()
+{
+    std::cout << "\n=== Testing number parsing ===" << std::endl;
+
+    std::vector<std::string> cases = {"0", "-0", "12.5", "129.99,x", "1e5", "1e", "1.5E-3\n", ".5", "5.", "-.", ".", "+7",
+                                      "abc", "0x1p3", "nan", "inf", "12.5GB", "99999999999999999999", "1234567890123456789",
+                                      "3.14159265358979323846", "  42", "9007199254740993", "1e22", "1e23", "4.9e-324"};
+    unsigned seed = 4711;
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string number;
+        seed = seed * 1103515245 + 12345;
+        unsigned kind = (seed >> 16) % 4;
+        if (kind == 0)
+            number += "-";
+        for (unsigned k = 0; k < (seed >> 8) % 22; ++k)
+            number += (char)('0' + (seed >> (k % 24)) % 10);
+        if (kind >= 1)
+            number += "." + std::to_string(seed % 1000000);
+        if (kind == 3)
+            number += "e" + std::to_string((int)(seed % 50) - 25);
+        cases.push_back(number + ",x");
+    }
+
+    char* page = (char*)aligned_alloc(4096, 8192);
+    for (const std::string& number : cases)
+    {
+        for (size_t pos : {(size_t)64, (size_t)67, 4096 - number.size() - 1, 4096 - number.size() - 4})
+        {
+            memset(page, 0, 8192);
+            memcpy(page + pos, number.c_str(), number.size() + 1);
+            const char* p = page + pos;
+
+            char* strtod_end;
+            const char* end;
+            double expected = strtod(p, &strtod_end);
+            double value = parse_double(p, &end);
+            assert(end == strtod_end && memcmp(&value, &expected, sizeof(double)) == 0);
+
+            char* strtol_end;
+            long expected_long = strtol(p, &strtol_end, 10);
+            assert(parse_long(p, &end) == expected_long && end == strtol_end);
+        }
+    }
+    free(page);
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Test: Texte aus dem Parser tragen ihre Länge, collect_shingles liest nur bis zum Textende
+void test_text_shingles()
+{
+    std::cout << "\n=== Testing length-carrying texts and shingles ===" << std::endl;
+
+    char text[64];
+    char* cursor = text;
+    uintptr_t fields[1] = {0};
+    static_parser<"%s">("abcde xy,\n", fields, &cursor);
+    text_view view = field_text(fields[0]);
+    assert(view.length == 8 && view.data[5] == (char)whitespace);
+
+    uint32_t out[8];
+    uint32_t count = 0;
+    collect_shingles(view, out, count);
+    uint32_t abcd, bcde, xy = 0; // Wörter unter 4 Zeichen: nur die eigenen Bytes, mit Nullen aufgefüllt
+    memcpy(&abcd, "abcd", 4);
+    memcpy(&bcde, "bcde", 4);
+    memcpy(&xy, "xy", 2);
+    assert(count == 3 && out[0] == abcd && out[1] == bcde && out[2] == xy);
+
+    count = 0;
+    collect_shingles(field_text((uintptr_t)empty_text), out, count);
+    assert(count == 0);
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+// Vergleicht zwei Slots (Text oder Zahl) zweier Parser-Ergebnisse
+bool same_field(uintptr_t a, uintptr_t b, bool text)
+{
+    if (!text)
+        return a == b;
+    text_view x = field_text(a), y = field_text(b);
+    return x.length == y.length && memcmp(x.data, y.data, x.length) == 0;
+}
+
+// Test: TSV und JSONL liefern dieselben Slots wie CSV, auch mit Escapes, \u-Zeichen, umsortierten,
+// fehlenden, zusätzlichen und verschachtelten Schlüsseln
+void test_dialects()
+{
+    std::cout << "\n=== Testing TSV and JSONL dialects ===" << std::endl;
+
+    assert(detect_dialect("%_,%V") == dialect_csv && detect_dialect("%_\t%V") == dialect_tsv);
+    assert(input_dialect("a/Z2.jsonl") == dialect_jsonl && input_dialect("Z2.ndjson.gz") == dialect_jsonl);
+    assert(input_dialect("Z2.tsv") == dialect_tsv && input_dialect("Z2.csv.zst") == dialect_csv && input_dialect("-") == dialect_csv);
+    assert(dialect_format("%_,%s,%*", dialect_tsv, {}) == "%_\t%s\t%*");
+    const std::string json_format = dialect_format("%_,%s,%*,%s,%s,%V", dialect_jsonl, {"id", "name", "price", "brand", "description", "category"});
+    assert(json_format == "{\"id\":%_,\"name\":%s,\"price\":%*,\"brand\":%s,\"description\":%s,\"category\":%V}");
+    assert(detect_dialect(json_format.c_str()) == dialect_jsonl && count_fields(json_format.c_str()) == 5);
+    bool thrown = false;
+    try { dialect_format("%_,%V", dialect_jsonl, {"id"}); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown);
+
+    char text[1024];
+    char* cursor = text;
+    uintptr_t csv[5], tsv[5], json[5];
+    const char* csv_line = "17,Qualität,12.5,\"USB \"\"3.0\"\"\",SD,\"Extreme, Pro\"\n";
+    const char* tsv_line = "17\tQualität\t12.5\t\"USB \"\"3.0\"\"\"\tSD\tExtreme, Pro\n";
+    const char* json_line = "{\"category\": \"Extreme, Pro\", \"brand\": \"USB \\\"3.0\\\"\", \"extra\": {\"a\": [1, \"}\"]},"
+                            " \"id\": 17, \"name\": \"Qualit\\u00e4t\", \"description\": \"SD\"}\n{\"id\":18}";
+    size_t csv_length = static_parser<"%_,%s,%*,%s,%s,%V">(csv_line, csv, &cursor);
+    size_t tsv_length = static_parser<"%_\t%s\t%*\t%s\t%s\t%V">(tsv_line, tsv, &cursor);
+    size_t json_length = static_parser<"{\"id\":%_,\"name\":%s,\"price\":%*,\"brand\":%s,\"description\":%s,\"category\":%V}">(json_line, json, &cursor);
+    assert(csv_length == strlen(csv_line) && tsv_length == strlen(tsv_line));
+    assert(json_line[json_length] == '{' && json_line[json_length + 6] == '1'); // hinter dem Zeilenende
+    for (int slot : {0, 2, 3, 4})
+    {
+        assert(same_field(csv[slot], tsv[slot], true));
+        assert(same_field(csv[slot], json[slot], true));
+    }
+    assert(field_text(json[2]).data[4] == (char)Escape);
+
+    // Fehlende Schlüssel bleiben leer, Zahlen dürfen in Anführungszeichen stehen
+    uintptr_t ids[2] = {1, 1};
+    const char* sparse = "{\"title\": null, \"id\": \"4730\"}\n";
+    assert(static_parser<"{\"id\":%d,\"title\":%s}">(sparse, ids, &cursor) == strlen(sparse));
+    assert(ids[0] == 4730 && field_text(ids[1]).length == 0);
+
+    std::cout << "Test passed!" << std::endl;
+}
+
+int main()
+{
+    std::cout << "Starting static parser tests...\n" << std::endl;
+
+    test_format_expansion();
+    test_builtin_parsers();
+    test_projection();
+    test_simd_field_scan();
+    test_simd_scan_bounds();
+    test_simd_normalize();
+    test_utf8_normalize();
+    test_number_parsing();
+    test_text_shingles();
+    test_dialects();
+
+    std::cout << "\nAll tests completed successfully!" << std::endl;
+    return 0;
+}